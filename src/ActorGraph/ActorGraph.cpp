@@ -11,26 +11,58 @@
 #include "ActorGraph.hpp"
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define CURRENT_YEAR 2019
 #define THIRD_COLUMN 2
+#define COLUMNS_PER_LINE 3
+#define MIN_CHUNK_BYTES 4096
 #define MOVIE_LEFT_BRACKET '['
 #define MOVIE_RIGHT_BRACKET ']'
 #define DELIMITER_BETWEEN_M_AND_Y "#@"
+#define BOTTOM_UP_DIVISOR 14
+#define MULTI_SOURCE_MIN_PAIRS 192
+#define MULTI_SOURCE_MAX_BYTES (256ULL * 1024 * 1024)
+#define DISTANCE_BLOCK 64
+#define SHARD_MIN_ACTORS 4096
+#define DELTA_STEP_WIDTH 16
+#define FINGERPRINT_OFFSET_BASIS 14695981039346656037ULL
+#define FINGERPRINT_PRIME 1099511628211ULL
 
 using namespace std;
 
 // for the priority queue in minimum spanning tree
 typedef pair<pair<ActorNode*, ActorNode*>, int> nodePair;
 
+// one row of the movie cast file, its strings still in the mapped file
+struct CastRow {
+    const char* actor;
+    const char* title;
+    unsigned int actorLength;
+    unsigned int titleLength;
+    unsigned int actorHash;
+    unsigned int titleHash;
+    int year;
+};
+
 /**
  * Constructor of the Actor graph
  */
-ActorGraph::ActorGraph(void) {}
+ActorGraph::ActorGraph(void)
+    : bipartite(false),
+      neighborMapsBuilt(false),
+      weightedMapsBuilt(false),
+      numThreads(1),
+      componentsStale(false) {}
 
 /*
  * The destructor for deallocating memory for each actor node
@@ -40,19 +72,276 @@ ActorGraph::ActorGraph(void) {}
  * Return: None
  */
 ActorGraph::~ActorGraph() {
-    for (auto iterator = graph.begin(); iterator != graph.end(); iterator++) {
-        delete iterator->second;
+    for (unsigned int i = 0; i < nodes.size(); i++) {
+        delete nodes[i];
+    }
+}
+
+/*
+ * Sets how many threads loading, building and searching the graph may use
+ *
+ * Parameters:
+ *              threads - the number of threads, 0 for one per core
+ *
+ * Return: None
+ */
+void ActorGraph::setNumThreads(unsigned int threads) {
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    numThreads = max(threads, 1u);
+}
+
+/*
+ * Returns how many threads loading, building and searching the graph may use
+ *
+ * Parameters: None
+ *
+ * Return: the number of threads
+ */
+unsigned int ActorGraph::getNumThreads() const { return numThreads; }
+
+/*
+ * Sets how many bytes the path cache may use
+ *
+ * Parameters:
+ *              bytes - the memory cap, 0 turns the cache off
+ *
+ * Return: None
+ */
+void ActorGraph::setPathCacheCapacity(size_t bytes) {
+    pathCache.setCapacity(bytes);
+}
+
+/*
+ * Returns the cache of the paths found so far, for its counters
+ *
+ * Parameters: None
+ *
+ * Return: the path cache
+ */
+const PathCache& ActorGraph::getPathCache() const { return pathCache; }
+
+/*
+ * Folds bytes into a 64-bit FNV-1a hash
+ *
+ * Parameters:
+ *              hash - the hash of everything before the bytes
+ *              bytes - the first of the bytes
+ *              length - the number of bytes
+ *
+ * Return: the hash including the bytes
+ */
+static unsigned long long hashBytes(unsigned long long hash, const void* bytes,
+                                    size_t length) {
+    const unsigned char* byte = (const unsigned char*)bytes;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ byte[i]) * FINGERPRINT_PRIME;
+    }
+    return hash;
+}
+
+/*
+ * Folds the elements of a frozen array into a 64-bit FNV-1a hash
+ *
+ * Parameters:
+ *              hash - the hash of everything before the array
+ *              array - the array to hash
+ *
+ * Return: the hash including the size and the elements of the array
+ */
+template <typename T>
+static unsigned long long hashArray(unsigned long long hash,
+                                   const FrozenArray<T>& array) {
+    unsigned long long size = array.size();
+    hash = hashBytes(hash, &size, sizeof(size));
+    return hashBytes(hash, array.data(), array.size() * sizeof(T));
+}
+
+/*
+ * Identifies the graph the cached paths were found in, so paths saved for
+ * another graph aren't used. The names, the movies and their years and who
+ * was in each movie all go into the hash, so any change to what the ids of
+ * a cached path stand for or to the ways between them gives another one. The
+ * rows are hashed one at a time, so rows grown by ingest hash the same as
+ * once packed, and both representations of a graph hash the same.
+ *
+ * Parameters: None
+ *
+ * Return: a hash of the contents of the graph
+ */
+unsigned long long ActorGraph::pathCacheFingerprint() const {
+    unsigned long long hash = FINGERPRINT_OFFSET_BASIS;
+    hash = hashArray(hash, actorNames.getChars());
+    hash = hashArray(hash, actorNames.getStarts());
+    hash = hashArray(hash, movieTitles.getChars());
+    hash = hashArray(hash, movieTitles.getStarts());
+    hash = hashArray(hash, movieTitleIds);
+    hash = hashArray(hash, movieYears);
+    for (unsigned int actorId = 0; actorId < nodes.size(); actorId++) {
+        int begin = bipartiteAdjacency.moviesBegin(actorId);
+        int numMovies = bipartiteAdjacency.moviesEnd(actorId) - begin;
+        hash = hashBytes(hash, &numMovies, sizeof(numMovies));
+        hash = hashBytes(hash, bipartiteAdjacency.actorMovies.data() + begin,
+                         numMovies * sizeof(int));
+    }
+    for (int movieId = 0; movieId < getNumMovies(); movieId++) {
+        int begin = bipartiteAdjacency.castBegin(movieId);
+        int castSize = bipartiteAdjacency.castEnd(movieId) - begin;
+        hash = hashBytes(hash, &castSize, sizeof(castSize));
+        hash = hashBytes(hash, bipartiteAdjacency.movieActors.data() + begin,
+                         castSize * sizeof(int));
     }
+    return hash;
+}
+
+/*
+ * Writes the cached paths to a file, usually next to the graph's snapshot
+ *
+ * Parameters:
+ *              filename - the file to write
+ *
+ * Return: true if the file was written, false otherwise
+ */
+bool ActorGraph::savePathCache(const char* filename) const {
+    return pathCache.save(filename, pathCacheFingerprint());
+}
+
+/*
+ * Reads the paths a run over the same graph saved before
+ *
+ * Parameters:
+ *              filename - the file to read
+ *
+ * Return: true if the file belonged to the graph and was read, false
+ * otherwise
+ */
+bool ActorGraph::loadPathCache(const char* filename) {
+    return pathCache.load(filename, pathCacheFingerprint());
+}
+
+/*
+ * Returns the search context of the calling thread, kept between searches so
+ * they don't allocate
+ *
+ * Parameters: None
+ *
+ * Return: the calling thread's search context
+ */
+SearchContext& ActorGraph::threadContext() {
+    static thread_local SearchContext context;
+    return context;
+}
+
+/*
+ * Returns the actor nodes for debugging purposes
+ *
+ * Parameters: None
+ *
+ * Return: every actor node indexed by its id
+ */
+const vector<ActorNode*>& ActorGraph::getGraph() const { return nodes; }
+
+/*
+ * Returns the frozen adjacency built at the end of buildGraph
+ *
+ * Parameters: None
+ *
+ * Return: the compressed sparse row adjacency of the graph
+ */
+const CSRAdjacency& ActorGraph::getAdjacency() const { return adjacency; }
+
+/*
+ * Looks up the id of the actor
+ *
+ * Parameters:
+ *              actorName - the name of the actor
+ *
+ * Return: the id of the actor, -1 if the actor doesn't exist
+ */
+int ActorGraph::getActorId(const string& actorName) const {
+    return actorNames.find(actorName);
+}
+
+/*
+ * Returns the name of the actor, used when printing results
+ *
+ * Parameters:
+ *              actorId - the id of the actor
+ *
+ * Return: the name of the actor
+ */
+string ActorGraph::getActorName(int actorId) const {
+    return actorNames.name(actorId);
 }
 
 /*
- * Returns the graph for debugging purposes
+ * Returns the node of the actor
+ *
+ * Parameters:
+ *              actorId - the id of the actor
+ *
+ * Return: the node of the actor
+ */
+ActorNode* ActorGraph::getNode(int actorId) const { return nodes[actorId]; }
+
+/*
+ * Returns the number of actors in the graph
+ *
+ * Parameters: None
+ *
+ * Return: the number of actors
+ */
+int ActorGraph::getNumActors() const { return nodes.size(); }
+
+/*
+ * Returns the number of movies in the graph
+ *
+ * Parameters: None
+ *
+ * Return: the number of movies
+ */
+int ActorGraph::getNumMovies() const { return movieYears.size(); }
+
+/*
+ * Tells which representation the graph was built with
  *
  * Parameters: None
  *
- * Return: the hashmap of the graph
+ * Return: true if built by buildBipartiteGraph, false if by buildGraph
+ */
+bool ActorGraph::isBipartite() const { return bipartite; }
+
+/*
+ * Finds how many movies the actor shares with each of its neighbors. When
+ * buildGraph filled the neighbors member of the node that is returned,
+ * otherwise it is counted through the actor's movies.
+ *
+ * Parameters:
+ *              actor - the node of the actor
+ *
+ * Return: the number of movies shared with each neighbor
  */
-unordered_map<string, ActorNode*> ActorGraph::getGraph() { return graph; }
+unordered_map<ActorNode*, int> ActorGraph::getNeighbors(
+    ActorNode* actor) const {
+    if (neighborMapsBuilt) {
+        return actor->neighbors;
+    }
+
+    unordered_map<ActorNode*, int> neighbors;
+    for (int i = bipartiteAdjacency.moviesBegin(actor->id);
+         i < bipartiteAdjacency.moviesEnd(actor->id); i++) {
+        int movieId = bipartiteAdjacency.actorMovies[i];
+        for (int j = bipartiteAdjacency.castBegin(movieId);
+             j < bipartiteAdjacency.castEnd(movieId); j++) {
+            ActorNode* neighbor = nodes[bipartiteAdjacency.movieActors[j]];
+            if (neighbor != actor) {
+                neighbors[neighbor] += 1;
+            }
+        }
+    }
+    return neighbors;
+}
 
 /*
  * Looks in graph to find if the actor exists
@@ -62,8 +351,8 @@ unordered_map<string, ActorNode*> ActorGraph::getGraph() { return graph; }
  *
  * Return: true - exists actor, false - doesn't exist actor
  */
-bool ActorGraph::checkIfActorExists(string actorName) {
-    if (graph.find(actorName) != graph.end()) {
+bool ActorGraph::checkIfActorExists(const string& actorName) const {
+    if (actorNames.find(actorName) != -1) {
         return true;
     }
     return false;
@@ -83,15 +372,19 @@ bool ActorGraph::checkIfActorExists(string actorName) {
  */
 void ActorGraph::minimumSpanningKruskal(
     unordered_map<ActorNode*, vector<pair<ActorNode*, int>>>& result) {
+    if (!weightedMapsBuilt) {
+        minimumSpanningBipartite(result);
+        return;
+    }
+
     // sorts with the least weight at highest priority and in case the same
     // weight use alphabetization
     priority_queue<nodePair, vector<nodePair>, WeightedPairComparator>
         kruskalQueue;
 
     // pushes all possible connections including the weight of each path
-    for (auto graphIterator = graph.begin(); graphIterator != graph.end();
-         graphIterator++) {
-        ActorNode* currentNode = graphIterator->second;
+    for (unsigned int actorId = 0; actorId < nodes.size(); actorId++) {
+        ActorNode* currentNode = nodes[actorId];
         for (auto neighborIterator = currentNode->neighborsWeighted.begin();
              neighborIterator != currentNode->neighborsWeighted.end();
              neighborIterator++) {
@@ -100,10 +393,8 @@ void ActorGraph::minimumSpanningKruskal(
                           neighborIterator->second));
         }
     }
-    unordered_map<ActorNode*, ActorNode*> upTree;
-    for (auto element : graph) {
-        upTree[element.second] = NULL;
-    }
+    // the parent of each actor's id in the up-tree
+    vector<ActorNode*> upTree(nodes.size(), NULL);
 
     while (!kruskalQueue.empty()) {
         nodePair current = kruskalQueue.top();
@@ -113,9 +404,9 @@ void ActorGraph::minimumSpanningKruskal(
 
         // checks to see if they both don't exist means no possible connections
         // already exist toward them
-        if (upTree[firstNode] == NULL && upTree[secondNode] == NULL) {
-            upTree[secondNode] = firstNode;
-            upTree[firstNode] = firstNode;
+        if (upTree[firstNode->id] == NULL && upTree[secondNode->id] == NULL) {
+            upTree[secondNode->id] = firstNode;
+            upTree[firstNode->id] = firstNode;
             result[firstNode].push_back(make_pair(secondNode, current.second));
             continue;
         } else {
@@ -130,30 +421,30 @@ void ActorGraph::minimumSpanningKruskal(
             vector<ActorNode*> nodesOnPath;  // all the nodes that have been
                                              // touched for path compression
 
-            while (upTree[secondNode] != secondNode) {
+            while (upTree[secondNode->id] != secondNode) {
                 nodesOnPath.push_back(secondNode);
-                if (upTree[secondNode] == NULL) break;
-                secondNode = upTree[secondNode];
+                if (upTree[secondNode->id] == NULL) break;
+                secondNode = upTree[secondNode->id];
                 secondNodeCount++;
             }
 
             // assign all nodes to the sentinel node to skip going up the tree.
             for (auto element : nodesOnPath) {
-                upTree[element] = secondNode;  // path compression
+                upTree[element->id] = secondNode;  // path compression
             }
             vector<ActorNode*> nodesOnPath2;
 
             // makes sure each node isn't pointing to itself which would mean
             // sentinel node
-            while (upTree[firstNode] != firstNode) {
+            while (upTree[firstNode->id] != firstNode) {
                 nodesOnPath.push_back(firstNode);
-                if (upTree[firstNode] == NULL) break;
-                firstNode = upTree[firstNode];
+                if (upTree[firstNode->id] == NULL) break;
+                firstNode = upTree[firstNode->id];
                 firstNodeCount++;
             }
 
             for (auto element : nodesOnPath2) {
-                upTree[element] = firstNode;
+                upTree[element->id] = firstNode;
             }
 
             // equal mean there is a cycle if this edge were to be inserted
@@ -161,9 +452,9 @@ void ActorGraph::minimumSpanningKruskal(
                 // which tree is assigned to which other tree depends on the
                 // size of each tree
                 if (secondNodeCount > firstNodeCount) {
-                    upTree[firstNode] = secondNode;
+                    upTree[firstNode->id] = secondNode;
                 } else {
-                    upTree[secondNode] = firstNode;
+                    upTree[secondNode->id] = firstNode;
                 }
 
                 // send the result of each edge of kruskal's algorithm
@@ -175,339 +466,2692 @@ void ActorGraph::minimumSpanningKruskal(
 }
 
 /*
- * With the given movies hash map, we iterate over each element across each
- * movie, knowing that all the nodes in the movie are related to each other by
- * this movie. Using left and right pointers to assign relations to each node's
- * edge member variable.
+ * Kruskal over the actor-movie adjacency. Every pair of actors in a movie has
+ * the movie's weight, so any tree linking the cast is as light as any other.
+ * The movies are taken from lightest to heaviest and each one links its cast
+ * to its first actor, skipping actors already in the same up-tree. The movie
+ * of each chosen edge is recorded in movieNeighborsWeighted for printing.
  *
  * Parameters:
- *              usingMovieTraveler - to check for using movie traveler
- *                                  executable
+ *              result - a reference to all the possible efficient connections
+ * of the tree
  *
  * Return: None
  */
-void ActorGraph::buildGraph(bool usingMovieTraveler) {
-    // searches through each movie
-    for (auto movieIterator = movies.begin(); movieIterator != movies.end();
-         movieIterator++) {
-        for (auto yearIterator = movieIterator->second.begin();
-             yearIterator != movieIterator->second.end(); yearIterator++) {
-            unsigned int left = 0;
-            unsigned int right = 1;
-            vector<ActorNode*> actors = yearIterator->second;
-
-            // less than one actor means no neighbors
-            if (actors.size() <= 1) {
-                continue;
-            }
-            string movieTitle = movieIterator->first;
-            int year = yearIterator->first;
-
-            // makes sure left isn't at end because then where would right be,
-            // off the array
-            while (left != actors.size() - 1) {
-                if (actors.at(left)->edges[movieTitle][year].at(0) == NULL) {
-                    actors.at(left)->edges[movieTitle][year].pop_back();
-                }
-                actors.at(left)->edges[movieTitle][year].push_back(
-                    actors[right]);
+void ActorGraph::minimumSpanningBipartite(
+    unordered_map<ActorNode*, vector<pair<ActorNode*, int>>>& result) {
+    int numMovies = bipartiteAdjacency.numMovies();
+    vector<int> movieOrder(numMovies);
+    for (int movieId = 0; movieId < numMovies; movieId++) {
+        movieOrder[movieId] = movieId;
+    }
+    stable_sort(movieOrder.begin(), movieOrder.end(), [this](int lhs, int rhs) {
+        return bipartiteAdjacency.movieWeights[lhs] <
+               bipartiteAdjacency.movieWeights[rhs];
+    });
+
+    // the parent of each actor id and the size of each up-tree
+    vector<int> upTree(nodes.size());
+    vector<int> treeSize(nodes.size(), 1);
+    for (unsigned int actorId = 0; actorId < upTree.size(); actorId++) {
+        upTree[actorId] = actorId;
+    }
 
-                // removes the placeholder that exists to put the actual
-                // neighbor there
-                if (actors.at(right)->edges[movieTitle][year].at(0) == NULL) {
-                    actors.at(right)->edges[movieTitle][year].pop_back();
-                }
-                actors.at(right)->edges[movieTitle][year].push_back(
-                    actors[left]);
-
-                // records the number of occurrences between neighbors
-                actors.at(left)->neighbors[actors.at(right)] += 1;
-
-                actors.at(right)->neighbors[actors.at(left)] += 1;
-
-                // only necessary when using the movie traveler function
-                if (usingMovieTraveler) {
-                    int movieWeight = edgeWeight(year);
-
-                    // makes sure the neighbor hasn't existed before
-                    bool rightNeighborOfLeftExists =
-                        actors.at(left)->neighborsWeighted.find(actors.at(
-                            right)) == actors.at(left)->neighborsWeighted.end()
-                            ? false
-                            : true;
-
-                    if (!rightNeighborOfLeftExists) {
-                        // keeps track of the movie weight that took the least
-                        // amount of weight between actors
-                        actors.at(left)->neighborsWeighted[actors.at(right)] =
-                            movieWeight;
-
-                        // keeps track of the movie that has the least weight
-                        actors.at(left)
-                            ->movieNeighborsWeighted[actors.at(right)] =
-                            formatMovieAndYear(movieTitle, year);
-                    } else {
-                        // updates values in case there is a movie with less
-                        // weight
-                        if (actors.at(left)
-                                ->neighborsWeighted[actors.at(right)] >
-                            movieWeight) {
-                            actors.at(left)
-                                ->neighborsWeighted[actors.at(right)] =
-                                movieWeight;
-                        }
-                    }
-                }
+    for (int movieId : movieOrder) {
+        int first = bipartiteAdjacency.castBegin(movieId);
+        int last = bipartiteAdjacency.castEnd(movieId);
+        int weight = bipartiteAdjacency.movieWeights[movieId];
+        ActorNode* firstNode = nodes[bipartiteAdjacency.movieActors[first]];
+
+        for (int i = first + 1; i < last; i++) {
+            ActorNode* secondNode = nodes[bipartiteAdjacency.movieActors[i]];
+
+            // finds both sentinels, path compressing on the way up
+            int firstRoot = firstNode->id;
+            int secondRoot = secondNode->id;
+            while (upTree[firstRoot] != firstRoot) {
+                upTree[firstRoot] = upTree[upTree[firstRoot]];
+                firstRoot = upTree[firstRoot];
+            }
+            while (upTree[secondRoot] != secondRoot) {
+                upTree[secondRoot] = upTree[upTree[secondRoot]];
+                secondRoot = upTree[secondRoot];
+            }
 
-                // moves the pointer down and up but never overlapping unless
-                // finished
-                if (actors.size() - 1 == right) {
-                    left++;
-                    right = left + 1;
-                } else {
-                    right++;
-                }
+            // equal means there is a cycle if this edge were to be inserted
+            if (firstRoot == secondRoot) {
+                continue;
+            }
+            if (treeSize[firstRoot] < treeSize[secondRoot]) {
+                swap(firstRoot, secondRoot);
             }
+            upTree[secondRoot] = firstRoot;
+            treeSize[firstRoot] += treeSize[secondRoot];
+
+            result[firstNode].push_back(make_pair(secondNode, weight));
+            firstNode->movieNeighborsWeighted[secondNode] = movieId;
         }
     }
 }
 
 /*
- * For the proper format of movies and year, the method formally returns the
- * correct semantics of a movie and year
+ * With the cast of each movie, every actor is related to every other actor in
+ * the movie. The actors are split into contiguous shards, one per thread, and
+ * each thread walks the movies of its own actors to assign relations to each
+ * node's neighbors and lay out its edges, so no two threads touch the same
+ * node. Finishes with the compressed sparse row adjacency used by the
+ * searches, the same as building it on one thread.
  *
  * Parameters:
- *              movie - the movie to be altered
- *              year - the year to be concatenated to the movie
+ *              usingMovieTraveler - to check for using movie traveler
+ *                                  executable
  *
- * Return: the formal version of the movie and year
+ * Return: None
  */
-string ActorGraph::formatMovieAndYear(string movie, int year) {
-    return MOVIE_LEFT_BRACKET + movie + DELIMITER_BETWEEN_M_AND_Y +
-           to_string(year) + MOVIE_RIGHT_BRACKET;
+void ActorGraph::buildGraph(bool usingMovieTraveler) {
+    bipartite = false;
+    buildMovieIndex();
+    rankActorNames();
+    buildAdjacency(true, usingMovieTraveler);
+    neighborMapsBuilt = true;
+    weightedMapsBuilt = usingMovieTraveler;
+    buildComponents();
 }
 
 /*
- * Using the given formula for edge weight, the method finds the weight of each
- * edge.
+ * Builds the actor-movie adjacency instead of linking every pair of actors in
+ * each movie. Each row read becomes one entry on each side, so the build is
+ * linear in the number of rows. The searches, the spanning tree and the
+ * neighbors of each actor all run on it directly.
  *
- * Parameters:
- *              movieYear - the year of the current movie
+ * Parameters: None
  *
- * Return: the weight as an int
+ * Return: None
  */
-int ActorGraph::edgeWeight(int movieYear) {
-    return CURRENT_YEAR - movieYear + 1;
+void ActorGraph::buildBipartiteGraph() {
+    bipartite = true;
+    neighborMapsBuilt = false;
+    weightedMapsBuilt = false;
+    adjacency.clear();
+    buildMovieIndex();
+    rankActorNames();
+    buildComponents();
 }
 
 /*
- * Using BFS and Dijkstra, the method searches the graph, having all nodes
- * initially having the distance of INT_MAX and accounting for nodes that have
- * had their neighbors added to queue, the method uses the movie weights to find
- * the shortest distance.
+ * Lays out the actor-movie adjacency from the cast of each movie, giving every
+ * actor its movies in increasing id. Both ways of building the graph keep it,
+ * it is what the snapshot and the spanning tree fall back on.
  *
- * Parameters:
- *              firstActor - the string of the first actor
- *              secondActor - the string of the second actor
+ * Parameters: None
  *
- * Return: the path from the first actor to the second actor as a vector,
- * alternating between movie and actors to represent the path.
+ * Return: None
  */
-vector<string> ActorGraph::shortestWeightedPath(string firstActor,
-                                                string secondActor) {
-    vector<string> path;
-    vector<ActorNode*> nodesTouched;
-    // an actor doesn't exist
-    if (!checkIfActorExists(firstActor) || !checkIfActorExists(secondActor)) {
-        return path;
+void ActorGraph::buildMovieIndex() {
+    bipartiteAdjacency.clear();
+    pathCache.clear();
+    buildLandmarks(0);
+    hierarchy.clear();
+    labels.clear();
+    int numMovies = movieCasts.size();
+    vector<int> movieOffsets(numMovies + 1, 0);
+    vector<int> movieActors;
+    vector<int> movieWeights(numMovies);
+
+    // the cast of each movie is laid out one movie after another
+    for (int movieId = 0; movieId < numMovies; movieId++) {
+        const vector<int>& cast = movieCasts[movieId];
+        movieOffsets[movieId + 1] = movieOffsets[movieId] + cast.size();
+        movieActors.insert(movieActors.end(), cast.begin(), cast.end());
+        movieWeights[movieId] = edgeWeight(movieYears[movieId]);
     }
 
-    // same actor, no path
-    if (firstActor == secondActor) {
-        return path;
-    }
-
-    priority_queue<ActorNode*, vector<ActorNode*>, WeightedComparator> bfsQueue;
-
-    // initializes all variables for the beginning and end of searching
-    ActorNode* start = graph[firstActor];
-    ActorNode* end = NULL;
-    start->dist = 0;
-    start->done = false;
-    start->prev = NULL;
-    bfsQueue.push(start);
-
-    // makes sure that queue has been checked
-    while (!bfsQueue.empty()) {
-        ActorNode* curr = bfsQueue.top();
-        bfsQueue.pop();
-        if (curr->done == false) {
-            curr->done = true;
-
-            // at this point there is no reason to search anymore
-            if (curr->nameOfActor == secondActor) {
-                end = curr;
-                break;
-            }
-
-            // searches all possible edges
-            for (auto movieNameIterator = curr->edges.begin();
-                 movieNameIterator != curr->edges.end(); movieNameIterator++) {
-                for (auto yearIterator = movieNameIterator->second.begin();
-                     yearIterator != movieNameIterator->second.end();
-                     yearIterator++) {
-                    for (unsigned int i = 0; i < yearIterator->second.size();
-                         i++) {
-                        ActorNode* adj = yearIterator->second.at(i);
-                        if (adj == NULL) {
-                            break;
-                        }
-
-                        // finds the distance so far including the current
-                        // neighbor's weight
-                        int distance =
-                            curr->dist + edgeWeight(yearIterator->first);
-
-                        // shorter distance, better path
-                        if (distance < adj->dist) {
-                            // sets the values to be correlating to the curr's
-                            // as the previous variable
-                            nodesTouched.push_back(adj);
-                            adj->dist = distance;
-                            adj->prev = curr;
-
-                            // used when forming the path later
-                            adj->nameOfConnector = formatMovieAndYear(
-                                movieNameIterator->first, yearIterator->first);
-                            bfsQueue.push(adj);
-                        }
-                    }
-                }
-            }
+    // counts the movies of each actor then fills each actor's slice, which
+    // leaves every actor's movies in increasing id
+    vector<int> actorOffsets(nodes.size() + 1, 0);
+    for (int actorId : movieActors) {
+        actorOffsets[actorId + 1]++;
+    }
+    for (unsigned int i = 1; i < actorOffsets.size(); i++) {
+        actorOffsets[i] += actorOffsets[i - 1];
+    }
+    vector<int> actorMovies(movieActors.size());
+    vector<int> cursor(actorOffsets.begin(), actorOffsets.end() - 1);
+    for (int movieId = 0; movieId < numMovies; movieId++) {
+        for (int actorId : movieCasts[movieId]) {
+            actorMovies[cursor[actorId]++] = movieId;
         }
     }
 
-    // makes sure that end is the node of the secondActor
-    if (end != NULL && end->nameOfActor == secondActor) {
-        // forms the path from the firstActor to the secondActor using a vector
-        while (end->prev != NULL) {
-            path.push_back(end->nameOfActor);
-            path.push_back(end->nameOfConnector);
-            end = end->prev;
-        }
-        path.push_back(end->nameOfActor);
+    bipartiteAdjacency.actorOffsets.assign(move(actorOffsets));
+    bipartiteAdjacency.actorMovies.assign(move(actorMovies));
+    bipartiteAdjacency.movieOffsets.assign(move(movieOffsets));
+    bipartiteAdjacency.movieActors.assign(move(movieActors));
+    bipartiteAdjacency.movieWeights.assign(move(movieWeights));
+}
 
-        // resets all values when touching each node
-        nodesTouched.push_back(start);
-        nodesTouched.push_back(end);
-        for (unsigned int i = 0; i < nodesTouched.size(); i++) {
-            nodesTouched.at(i)->dist = INT_MAX;
-            nodesTouched.at(i)->done = false;
-            nodesTouched.at(i)->prev = NULL;
-        }
-        return path;
+/*
+ * Sorts the actors by name and stores each actor's position so ties in the
+ * searches can compare integers instead of strings
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void ActorGraph::rankActorNames() {
+    vector<int> byName(nodes.size());
+    for (unsigned int i = 0; i < byName.size(); i++) {
+        byName[i] = i;
+    }
+    sort(byName.begin(), byName.end(), [this](int lhs, int rhs) {
+        return actorNames.less(lhs, rhs);
+    });
+    for (unsigned int rank = 0; rank < byName.size(); rank++) {
+        nodes[byName[rank]]->nameRank = rank;
     }
 }
 
 /*
- * Using BFS and Dijkstra, the method searches the graph, having all nodes
- * initially having the distance of INT_MAX to account for each node already
- * touched, then finding the distance from the first actor to the second actor
- * and returning this path
+ * Keeps the lightest movie relating the actor to a neighbor later in the
+ * movie's cast, the first one read when more than one is as light
  *
  * Parameters:
- *              firstActor - the string of the first actor
- *              secondActor - the string of the second actor
+ *              actor - the actor earlier in the cast
+ *              neighbor - the actor later in the cast
+ *              movieId - the movie that relates the two actors
+ *              weight - the weight of the movie
  *
- * Return: the path from the first actor to the second actor as a vector,
- * alternating between movie and actors to represent the path.
+ * Return: None
  */
-vector<string> ActorGraph::shortestUnweightedPath(string firstActor,
-                                                  string secondActor) {
-    vector<string> path;
-    vector<ActorNode*> nodesTouched;
-    // an actor doesn't exist
-    if (!checkIfActorExists(firstActor) || !checkIfActorExists(secondActor)) {
-        return path;
+static void linkLightestMovie(ActorNode* actor, ActorNode* neighbor,
+                              int movieId, int weight) {
+    auto weighted = actor->neighborsWeighted.find(neighbor);
+    if (weighted == actor->neighborsWeighted.end()) {
+        // keeps track of the movie weight that took the least amount of
+        // weight between actors
+        actor->neighborsWeighted[neighbor] = weight;
+
+        // keeps track of the movie that has the least weight
+        actor->movieNeighborsWeighted[neighbor] = movieId;
+    } else if (weighted->second > weight) {
+        // updates values in case there is a movie with less weight
+        weighted->second = weight;
+        actor->movieNeighborsWeighted[neighbor] = movieId;
     }
+}
 
-    // checks for the case of actors being the same
-    if (firstActor == secondActor) {
-        return path;
+/*
+ * Splits the actors into one contiguous shard per thread, each with about the
+ * same number of movie roles so the threads finish together
+ *
+ * Parameters: None
+ *
+ * Return: the first actor id of each shard followed by the number of actors
+ */
+vector<int> ActorGraph::shardActors() const {
+    int numActors = nodes.size();
+    int numShards = max(1, min((int)numThreads, numActors));
+    const FrozenArray<int>& roles = bipartiteAdjacency.actorOffsets;
+    vector<int> bounds(numShards + 1, numActors);
+    bounds[0] = 0;
+    for (int shard = 1; shard < numShards; shard++) {
+        long long target = (long long)roles.back() * shard / numShards;
+        int actorId = lower_bound(roles.begin(), roles.end(), target) -
+                      roles.begin();
+        bounds[shard] = max(bounds[shard - 1], min(actorId, numActors));
     }
+    return bounds;
+}
 
-    queue<ActorNode*> bfsQueue;
-    ActorNode* start = graph[firstActor];
-
-    // pushes the first node as the initial node
-    start->dist = 0;
-    bfsQueue.push(start);
-
-    // if something in queue, means still nodes to traverse
-    while (!bfsQueue.empty()) {
-        ActorNode* curr = bfsQueue.front();
-        bfsQueue.pop();
+/*
+ * Runs the work on every shard, the first on the calling thread and the rest
+ * on threads of their own, and waits for all of them
+ *
+ * Parameters:
+ *              numShards - the number of shards
+ *              work - called with the index of each shard
+ *
+ * Return: None
+ */
+template <typename Work>
+static void runShards(int numShards, Work work) {
+    vector<thread> workers;
+    for (int shard = 1; shard < numShards; shard++) {
+        workers.emplace_back(work, shard);
+    }
+    work(0);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
 
-        // iterates through each edge of the starting node
-        for (auto movieNameIterator = curr->edges.begin();
-             movieNameIterator != curr->edges.end(); movieNameIterator++) {
-            for (auto yearIterator = movieNameIterator->second.begin();
-                 yearIterator != movieNameIterator->second.end();
-                 yearIterator++) {
-                for (unsigned int i = 0; i < yearIterator->second.size(); i++) {
-                    ActorNode* adj = yearIterator->second.at(i);
+/*
+ * Lays out the edges of every actor into the compressed sparse row adjacency.
+ * Each actor's edges are grouped by movie id and follow the order of the
+ * movie's cast within each movie. The degrees, their prefix sums and the
+ * edges are worked out by shard on every thread. The same walk can fill the
+ * neighbor maps of each node the way buildGraph always has.
+ *
+ * Parameters:
+ *              linkNodes - fill the neighbors member of each node
+ *              usingMovieTraveler - also fill neighborsWeighted and
+ *                                   movieNeighborsWeighted
+ *
+ * Return: None
+ */
+void ActorGraph::buildAdjacency(bool linkNodes, bool usingMovieTraveler) {
+    adjacency.clear();
+    const BipartiteAdjacency& index = bipartiteAdjacency;
+    vector<int> bounds = shardActors();
+    int numShards = bounds.size() - 1;
+
+    // counts the edges of each actor, one per other member of each cast, and
+    // the edges of each shard
+    vector<int> offsets(nodes.size() + 1, 0);
+    vector<int> shardEdges(numShards + 1, 0);
+    runShards(numShards, [&](int shard) {
+        int edges = 0;
+        for (int actorId = bounds[shard]; actorId < bounds[shard + 1];
+             actorId++) {
+            int degree = 0;
+            for (int i = index.moviesBegin(actorId);
+                 i < index.moviesEnd(actorId); i++) {
+                int movieId = index.actorMovies[i];
+                degree += index.castEnd(movieId) -
+                          index.castBegin(movieId) - 1;
+            }
+            offsets[actorId + 1] = degree;
+            edges += degree;
+        }
+        shardEdges[shard + 1] = edges;
+    });
 
-                    // no node, no push to the queue
-                    if (adj == NULL) {
-                        break;
+    // turns the counts into the starting index of each actor's slice, each
+    // shard starting after the edges of the shards before it
+    for (int shard = 1; shard <= numShards; shard++) {
+        shardEdges[shard] += shardEdges[shard - 1];
+    }
+    runShards(numShards, [&](int shard) {
+        int edges = shardEdges[shard];
+        for (int actorId = bounds[shard]; actorId < bounds[shard + 1];
+             actorId++) {
+            edges += offsets[actorId + 1];
+            offsets[actorId + 1] = edges;
+        }
+    });
+    int numEdges = offsets.back();
+    vector<int> neighbors(numEdges);
+    vector<int> movieIds(numEdges);
+    vector<int> weights(numEdges);
+
+    // fills each actor's slice by walking its movies in increasing id
+    runShards(numShards, [&](int shard) {
+        for (int actorId = bounds[shard]; actorId < bounds[shard + 1];
+             actorId++) {
+            ActorNode* actor = nodes[actorId];
+            int edge = offsets[actorId];
+
+            // an actor listed twice in a movie has the movie twice, the
+            // occurrence says which of its places in the cast is its own
+            int occurrence = 0;
+            for (int i = index.moviesBegin(actorId);
+                 i < index.moviesEnd(actorId); i++) {
+                int movieId = index.actorMovies[i];
+                bool repeated = i > index.moviesBegin(actorId) &&
+                                index.actorMovies[i - 1] == movieId;
+                occurrence = repeated ? occurrence + 1 : 0;
+                int weight = index.movieWeights[movieId];
+
+                int seen = 0;
+                bool pastSelf = false;
+                for (int j = index.castBegin(movieId);
+                     j < index.castEnd(movieId); j++) {
+                    int neighborId = index.movieActors[j];
+                    if (neighborId == actorId && seen++ == occurrence) {
+                        pastSelf = true;
+                        continue;
                     }
-
-                    // the node hasn't been touched, checking for cycles
-                    if (adj->dist == INT_MAX) {
-                        nodesTouched.push_back(adj);
-                        adj->dist = curr->dist + 1;
-                        adj->prev = curr;
-                        adj->nameOfConnector = formatMovieAndYear(
-                            movieNameIterator->first, yearIterator->first);
-                        bfsQueue.push(adj);
+                    neighbors[edge] = neighborId;
+                    movieIds[edge] = movieId;
+                    weights[edge] = weight;
+                    edge++;
+                    if (!linkNodes) {
+                        continue;
                     }
 
-                    // found a match, closest unweighted by bfs
-                    if (adj->nameOfActor == secondActor) {
-                        // saves the path found by alternating through movies
-                        // and actors
-                        for (int i = adj->dist; i >= 1; i--) {
-                            path.push_back(adj->nameOfActor);
-                            path.push_back(adj->nameOfConnector);
-                            adj = adj->prev;
-                        }
-                        path.push_back(adj->nameOfActor);
+                    // records the number of occurrences between neighbors
+                    ActorNode* neighbor = nodes[neighborId];
+                    actor->neighbors[neighbor] += 1;
 
-                        // resets distances of all nodes touched
-                        nodesTouched.push_back(adj);
-                        nodesTouched.push_back(start);
-                        for (unsigned int i = 0; i < nodesTouched.size(); i++) {
-                            nodesTouched.at(i)->dist = INT_MAX;
-                        }
-                        return path;
+                    // only necessary when using the movie traveler function,
+                    // and only toward actors later in the cast
+                    if (!usingMovieTraveler || !pastSelf) {
+                        continue;
                     }
+                    linkLightestMovie(actor, neighbor, movieId, weight);
                 }
             }
         }
-    }
+    });
 
-    // resets all touched nodes distances
-    nodesTouched.push_back(start);
-    for (unsigned int i = 0; i < nodesTouched.size(); i++) {
-        nodesTouched.at(i)->dist = INT_MAX;
-    }
-    return path;
+    adjacency.offsets.assign(move(offsets));
+    adjacency.neighbors.assign(move(neighbors));
+    adjacency.movieIds.assign(move(movieIds));
+    adjacency.weights.assign(move(weights));
 }
-/** You can modify this method definition as you wish
- *
- * Load the graph from a tab-delimited file of actor->movie
+
+/*
+ * For the proper format of movies and year, the method formally returns the
+ * correct semantics of a movie and year
+ *
+ * Parameters:
+ *              movie - the movie to be altered
+ *              year - the year to be concatenated to the movie
+ *
+ * Return: the formal version of the movie and year
+ */
+string ActorGraph::formatMovieAndYear(const string& movie, int year) const {
+    return MOVIE_LEFT_BRACKET + movie + DELIMITER_BETWEEN_M_AND_Y +
+           to_string(year) + MOVIE_RIGHT_BRACKET;
+}
+
+/*
+ * Formats the movie of the id the same way as formatMovieAndYear, used when
+ * printing results
+ *
+ * Parameters:
+ *              movieId - the id of the movie
+ *
+ * Return: the formal version of the movie and year
+ */
+string ActorGraph::formatMovie(int movieId) const {
+    return formatMovieAndYear(movieTitles.name(movieTitleIds[movieId]),
+                              movieYears[movieId]);
+}
+
+/*
+ * Writes the name of the actor straight from where the names are kept,
+ * without building a string, used when printing many results
+ *
+ * Parameters:
+ *              out - the stream to write to
+ *              actorId - the id of the actor
+ *
+ * Return: None
+ */
+void ActorGraph::writeActorName(ostream& out, int actorId) const {
+    out.write(actorNames.data(actorId), actorNames.length(actorId));
+}
+
+/*
+ * Writes the movie of the id the way formatMovie formats it, without
+ * building a string, used when printing many results
+ *
+ * Parameters:
+ *              out - the stream to write to
+ *              movieId - the id of the movie
+ *
+ * Return: None
+ */
+void ActorGraph::writeMovie(ostream& out, int movieId) const {
+    int titleId = movieTitleIds[movieId];
+    out << MOVIE_LEFT_BRACKET;
+    out.write(movieTitles.data(titleId), movieTitles.length(titleId));
+    out << DELIMITER_BETWEEN_M_AND_Y << movieYears[movieId]
+        << MOVIE_RIGHT_BRACKET;
+}
+
+/*
+ * Using the given formula for edge weight, the method finds the weight of each
+ * edge. A movie from after CURRENT_YEAR weighs 1 like one from that year, so
+ * no edge is free or negative and the weighted searches stay in order.
+ *
+ * Parameters:
+ *              movieYear - the year of the current movie
+ *
+ * Return: the weight as an int, at least 1
+ */
+int ActorGraph::edgeWeight(int movieYear) const {
+    return max(1, CURRENT_YEAR - movieYear + 1);
+}
+
+/*
+ * Using BFS and Dijkstra, the method searches the graph, having all nodes
+ * initially having the distance of INT_MAX and accounting for nodes that have
+ * had their neighbors added to queue, the method uses the movie weights to find
+ * the shortest distance.
+ *
+ * Parameters:
+ *              firstActor - the string of the first actor
+ *              secondActor - the string of the second actor
+ *
+ * Return: the path from the first actor to the second actor as a vector,
+ * alternating between movie and actors to represent the path.
+ */
+vector<string> ActorGraph::shortestWeightedPath(
+    const string& firstActor, const string& secondActor) const {
+    return shortestWeightedPath(firstActor, secondActor, threadContext());
+}
+
+/*
+ * Using BFS and Dijkstra, the method searches the graph, having all nodes
+ * initially having the distance of INT_MAX and accounting for nodes that have
+ * had their neighbors added to queue, the method uses the movie weights to find
+ * the shortest distance. The search state lives in the given context, so
+ * threads can search at once with a context each.
+ *
+ * Parameters:
+ *              firstActor - the string of the first actor
+ *              secondActor - the string of the second actor
+ *              context - the search state to use
+ *
+ * Return: the path from the first actor to the second actor as a vector,
+ * alternating between movie and actors to represent the path.
+ */
+vector<string> ActorGraph::shortestWeightedPath(
+    const string& firstActor, const string& secondActor,
+    SearchContext& context) const {
+    int firstId = actorNames.find(firstActor);
+    int secondId = actorNames.find(secondActor);
+
+    // an actor doesn't exist
+    if (firstId == -1 || secondId == -1) {
+        return vector<string>();
+    }
+
+    // same actor, no path
+    if (firstId == secondId) {
+        return vector<string>();
+    }
+
+    // both representations leave the same prev and connector behind
+    return formatPath(findPath(firstId, secondId, true, context));
+}
+
+/*
+ * Finds a lightest path between the two actors the way shortestWeightedPath
+ * does, but only if its movies weigh no more than the given total. The
+ * search gives up as soon as every way that light was searched.
+ *
+ * Parameters:
+ *              firstActor - the string of the first actor
+ *              secondActor - the string of the second actor
+ *              maxWeight - the most the movies of the path may weigh
+ *
+ * Return: the path from the first actor to the second actor as a vector,
+ * alternating between movie and actors to represent the path, empty if
+ * there is none within maxWeight.
+ */
+vector<string> ActorGraph::shortestWeightedPath(const string& firstActor,
+                                                const string& secondActor,
+                                                int maxWeight) const {
+    SearchContext& context = threadContext();
+    context.limit = maxWeight;
+    vector<string> path =
+        shortestWeightedPath(firstActor, secondActor, context);
+    context.limit = INT_MAX;
+    return path;
+}
+
+/*
+ * Using BFS and Dijkstra, the method searches the graph, having all nodes
+ * initially having the distance of INT_MAX to account for each node already
+ * touched, then finding the distance from the first actor to the second actor
+ * and returning this path
+ *
+ * Parameters:
+ *              firstActor - the string of the first actor
+ *              secondActor - the string of the second actor
+ *
+ * Return: the path from the first actor to the second actor as a vector,
+ * alternating between movie and actors to represent the path.
+ */
+vector<string> ActorGraph::shortestUnweightedPath(
+    const string& firstActor, const string& secondActor) const {
+    return shortestUnweightedPath(firstActor, secondActor, threadContext());
+}
+
+/*
+ * Using BFS and Dijkstra, the method searches the graph, having all nodes
+ * initially having the distance of INT_MAX to account for each node already
+ * touched, then finding the distance from the first actor to the second actor
+ * and returning this path. The search state lives in the given context, so
+ * threads can search at once with a context each.
+ *
+ * Parameters:
+ *              firstActor - the string of the first actor
+ *              secondActor - the string of the second actor
+ *              context - the search state to use
+ *
+ * Return: the path from the first actor to the second actor as a vector,
+ * alternating between movie and actors to represent the path.
+ */
+vector<string> ActorGraph::shortestUnweightedPath(
+    const string& firstActor, const string& secondActor,
+    SearchContext& context) const {
+    int firstId = actorNames.find(firstActor);
+    int secondId = actorNames.find(secondActor);
+
+    // an actor doesn't exist
+    if (firstId == -1 || secondId == -1) {
+        return vector<string>();
+    }
+
+    // checks for the case of actors being the same
+    if (firstId == secondId) {
+        return vector<string>();
+    }
+
+    return formatPath(findPath(firstId, secondId, false, context));
+}
+
+/*
+ * Finds a shortest path between the two actors the way shortestUnweightedPath
+ * does, but only if it takes no more than the given number of movies. The
+ * search gives up as soon as every way that short was searched, so two
+ * actors far apart cost no more than two near ones.
+ *
+ * Parameters:
+ *              firstActor - the string of the first actor
+ *              secondActor - the string of the second actor
+ *              maxHops - the most movies the path may take
+ *
+ * Return: the path from the first actor to the second actor as a vector,
+ * alternating between movie and actors to represent the path, empty if
+ * there is none within maxHops.
+ */
+vector<string> ActorGraph::shortestUnweightedPath(const string& firstActor,
+                                                  const string& secondActor,
+                                                  int maxHops) const {
+    SearchContext& context = threadContext();
+    context.limit = maxHops;
+    vector<string> path =
+        shortestUnweightedPath(firstActor, secondActor, context);
+    context.limit = INT_MAX;
+    return path;
+}
+
+/*
+ * Finds the actors within the bound of the center with a one way BFS or
+ * Dijkstra that stops as soon as the next actor would be past it, so only
+ * the neighborhood itself is searched
+ *
+ * Parameters:
+ *              actorName - the name of the actor at the center
+ *              bound - the most movies or total weight from the center
+ *              useWeighted - use the movie weights instead of hop counts
+ *
+ * Return: every actor within the bound in order of distance, the center
+ * first, each with the actor and movie before it on a shortest path, empty
+ * if the actor doesn't exist or the bound is negative
+ */
+vector<NeighborhoodEntry> ActorGraph::neighborhood(const string& actorName,
+                                                   int bound,
+                                                   bool useWeighted) const {
+    vector<NeighborhoodEntry> found;
+    int center = actorNames.find(actorName);
+    if (center == -1 || bound < 0) {
+        return found;
+    }
+    SearchContext& context = threadContext();
+    context.begin(nodes.size(), getNumMovies());
+    context.reach(center, 0, -1, -1);
+    auto add = [&](int actorId) {
+        found.push_back({actorId, context.dist(actorId), context.prev(actorId),
+                         context.connector(actorId)});
+    };
+
+    if (!useWeighted) {
+        // the frontier is in order of hops, and the actors at the bound
+        // aren't expanded
+        context.frontier.push_back(center);
+        for (unsigned int head = 0; head < context.frontier.size(); head++) {
+            int curr = context.frontier[head];
+            add(curr);
+            int distance = context.dist(curr) + 1;
+            if (distance > bound) {
+                continue;
+            }
+            visitNeighbors(curr, context, [&](int adj, int movieId, int) {
+                if (!context.reached(adj)) {
+                    context.reach(adj, distance, curr, movieId);
+                    context.frontier.push_back(adj);
+                }
+            });
+        }
+        return found;
+    }
+
+    context.queue.push({0, nodes[center]->nameRank, center});
+    while (!context.queue.empty()) {
+        int curr = context.queue.pop().actorId;
+        if (context.done(curr)) {
+            continue;
+        }
+        context.finish(curr);
+        add(curr);
+        int currDist = context.dist(curr);
+        visitNeighbors(curr, context, [&](int adj, int movieId, int weight) {
+            int distance = currDist + weight;
+            if (distance <= bound && distance < context.dist(adj)) {
+                context.reach(adj, distance, curr, movieId);
+                context.queue.push({distance, nodes[adj]->nameRank, adj});
+            }
+        });
+    }
+    return found;
+}
+
+/*
+ * Finds the number of hops from the actor to every actor with a level
+ * synchronous BFS on all of the graph's threads
+ *
+ * Parameters:
+ *              actorName - the name of the actor to search from
+ *
+ * Return: the hops to each actor indexed by id, -1 for the actors it doesn't
+ * reach, empty if the actor doesn't exist
+ */
+vector<int> ActorGraph::unweightedDistances(const string& actorName) const {
+    ActorDistances result;
+    allDistances(actorName, false, false, result);
+    return result.distances;
+}
+
+/*
+ * Finds the distance from the actor to every actor in one traversal on all
+ * of the graph's threads, with a level synchronous BFS for hop counts or
+ * delta stepping for the movie weights. The distances are exact, but of
+ * several shortest paths the actor and movie before each actor may lie on
+ * another than a one way search would find.
+ *
+ * Parameters:
+ *              actorName - the name of the actor to search from
+ *              useWeighted - use the movie weights instead of hop counts
+ *              withPrevious - also find the actor and movie before each
+ *              result - set to the distances, and the actors and movies
+ *                       before each if asked for
+ *
+ * Return: false if the actor doesn't exist, true otherwise
+ */
+bool ActorGraph::allDistances(const string& actorName, bool useWeighted,
+                              bool withPrevious,
+                              ActorDistances& result) const {
+    result = ActorDistances();
+    int start = actorNames.find(actorName);
+    if (start == -1) {
+        return false;
+    }
+    vector<atomic<int>> distances(nodes.size());
+    if (useWeighted) {
+        deltaStepping(start, distances);
+    } else {
+        parallelBFS(start, distances);
+    }
+    result.distances.reserve(nodes.size());
+    for (const atomic<int>& distance : distances) {
+        result.distances.push_back(distance.load(memory_order_relaxed));
+    }
+    if (withPrevious) {
+        findPrevious(useWeighted, result);
+    }
+    return true;
+}
+
+/*
+ * Looks the pair up in the path cache, searching the graph for it and caching
+ * what was found on a miss. A path past the context's limit isn't returned,
+ * and a search that found nothing within the limit isn't cached, since the
+ * pair may still be connected.
+ *
+ * Parameters:
+ *              firstId - the id of the first actor
+ *              secondId - the id of the second actor, not the first
+ *              useWeighted - use the movie weights instead of hop counts
+ *              context - the search state to use on a miss
+ *
+ * Return: the ids along the path from the second actor back to the first,
+ * empty if the actors aren't connected within the limit
+ */
+vector<int> ActorGraph::findPath(int firstId, int secondId, bool useWeighted,
+                                 SearchContext& context) const {
+    vector<int> path;
+    if (pathCache.find(firstId, secondId, useWeighted, path)) {
+        return pathLength(path, useWeighted) <= context.limit ? path
+                                                              : vector<int>();
+    }
+    context.begin(nodes.size(), getNumMovies());
+    if (pairSearch(firstId, secondId, useWeighted, context)) {
+        path = tracePath(secondId, context);
+    }
+    if (!path.empty() || context.limit == INT_MAX) {
+        pathCache.insert(firstId, secondId, useWeighted, path);
+    }
+    return path;
+}
+
+/*
+ * Adds up the length of a path laid out the way findPath returns it
+ *
+ * Parameters:
+ *              path - the ids along the path, movie ids in between actor ids
+ *              useWeighted - use the movie weights instead of hop counts
+ *
+ * Return: the number of movies or the total weight of the movies on the
+ * path, 0 for an empty one
+ */
+int ActorGraph::pathLength(const vector<int>& path, bool useWeighted) const {
+    if (!useWeighted) {
+        return path.size() / 2;
+    }
+    int length = 0;
+    for (unsigned int i = 1; i < path.size(); i += 2) {
+        length += bipartiteAdjacency.movieWeights[path[i]];
+    }
+    return length;
+}
+
+/*
+ * Finds the shortest path of every pair on all of the graph's threads. The
+ * pairs are grouped by their first actor, and each group is searched once,
+ * from both ends if it only has one second actor, or else from the first
+ * actor until every second actor is found. The groups are handed out as
+ * threads free up, so a few long searches don't hold up the rest, and each
+ * thread searches with a context of its own. A weighted batch over a
+ * contraction hierarchy goes up it for each pair instead, and an unweighted
+ * batch over distance labels follows them for each pair. An unweighted batch
+ * without labels first runs bit-parallel BFS from the second actors many of
+ * its pairs share. Pairs in the path cache aren't searched at all.
+ *
+ * Parameters:
+ *              pairs - the first and second actor of each search
+ *              useWeighted - use the movie weights instead of hop counts
+ *
+ * Return: the ids along the path of each pair in the order of the pairs,
+ * alternating between actor ids and movie ids from the second actor back to
+ * the first, empty where there is none
+ */
+vector<vector<int>> ActorGraph::shortestPathIds(
+    const vector<pair<string, string>>& pairs, bool useWeighted) const {
+    vector<vector<int>> paths(pairs.size());
+
+    // pairs with an unknown or repeated actor or in different components
+    // have no path to find, and the paths found before come straight from
+    // the cache
+    vector<pair<int, int>> queries;  // the first actor and index of each
+    vector<int> ends(pairs.size());
+    vector<int> cached;
+    for (unsigned int i = 0; i < pairs.size(); i++) {
+        int firstId = actorNames.find(pairs[i].first);
+        ends[i] = actorNames.find(pairs[i].second);
+        if (firstId == -1 || ends[i] == -1 || firstId == ends[i] ||
+            !sameComponent(firstId, ends[i])) {
+            continue;
+        }
+        if (pathCache.find(firstId, ends[i], useWeighted, cached)) {
+            paths[i] = cached;
+        } else {
+            queries.emplace_back(firstId, i);
+        }
+    }
+
+    // a BFS from the second actors many pairs share serves them at once
+    if (!useWeighted && labels.empty()) {
+        multiSourcePaths(queries, ends, paths);
+    }
+
+    // puts the pairs of the same first actor next to each other
+    sort(queries.begin(), queries.end());
+    vector<int> groups;  // where each first actor's pairs begin, then the end
+    for (unsigned int q = 0; q < queries.size(); q++) {
+        if (q == 0 || queries[q].first != queries[q - 1].first) {
+            groups.push_back(q);
+        }
+    }
+    groups.push_back(queries.size());
+
+    int numGroups = groups.size() - 1;
+    int numShards = max(1, min((int)numThreads, numGroups));
+    atomic<int> nextGroup(0);
+    runShards(numShards, [&](int) {
+        SearchContext context;
+        vector<int> targets;
+        for (int group = nextGroup++; group < numGroups; group = nextGroup++) {
+            int start = queries[groups[group]].first;
+            targets.clear();
+            for (int q = groups[group]; q < groups[group + 1]; q++) {
+                targets.push_back(ends[queries[q].second]);
+            }
+            sort(targets.begin(), targets.end());
+            targets.erase(unique(targets.begin(), targets.end()),
+                          targets.end());
+
+            // the hierarchy and the labels answer each pair sooner than
+            // one search from the first actor finds every second actor
+            bool eachPair =
+                targets.size() == 1 ||
+                (useWeighted ? !hierarchy.empty() : !labels.empty());
+            if (!eachPair) {
+                context.begin(nodes.size(), getNumMovies());
+                searchFrom(start, targets, useWeighted, context);
+            }
+
+            // every second actor reached has its final prev and connector
+            int searched = -1;  // the second actor the context searched for
+            for (int q = groups[group]; q < groups[group + 1]; q++) {
+                int i = queries[q].second;
+                if (eachPair && ends[i] != searched) {
+                    context.begin(nodes.size(), getNumMovies());
+                    pairSearch(start, ends[i], useWeighted, context);
+                    searched = ends[i];
+                }
+                vector<int> path;
+                if (context.reached(ends[i])) {
+                    path = tracePath(ends[i], context);
+                }
+                pathCache.insert(start, ends[i], useWeighted, path);
+                paths[i] = move(path);
+            }
+        }
+    });
+    return paths;
+}
+
+/*
+ * Finds the shortest path of every pair the way shortestPathIds does, then
+ * formats each actor and movie along them
+ *
+ * Parameters:
+ *              pairs - the first and second actor of each search
+ *              useWeighted - use the movie weights instead of hop counts
+ *
+ * Return: the path of each pair in the order of the pairs, each laid out the
+ * way shortestUnweightedPath and shortestWeightedPath return them
+ */
+vector<vector<string>> ActorGraph::shortestPaths(
+    const vector<pair<string, string>>& pairs, bool useWeighted) const {
+    vector<vector<int>> found = shortestPathIds(pairs, useWeighted);
+    vector<vector<string>> paths(found.size());
+    for (unsigned int i = 0; i < found.size(); i++) {
+        paths[i] = formatPath(found[i]);
+    }
+    return paths;
+}
+
+/*
+ * Finds the paths of the pairs sharing their second actors with bit-parallel
+ * BFS from those actors, MULTI_SOURCE_WIDTH at a time, each batch handed out
+ * as a thread frees up. Every pair then follows the distances to its second
+ * actor from its first. One BFS over the whole graph costs about as much as
+ * a few hundred searches from both ends, so the second actors are batched
+ * from the most shared down, and only while a batch answers at least
+ * MULTI_SOURCE_MIN_PAIRS pairs. A search that runs too deep falls back to
+ * searching each of its pairs on its own. Each thread keeps a byte for every
+ * actor from each source, so no more threads batch than fit in
+ * MULTI_SOURCE_MAX_BYTES, and a graph too large for even one leaves every
+ * pair to the searches from both ends.
+ *
+ * Parameters:
+ *              queries - the first actor and the index of each pair, left
+ *                        with the pairs not answered
+ *              ends - the second actor of every pair by index
+ *              paths - set to the ids along the path of each pair answered
+ *                      by index
+ *
+ * Return: None
+ */
+void ActorGraph::multiSourcePaths(vector<pair<int, int>>& queries,
+                                  const vector<int>& ends,
+                                  vector<vector<int>>& paths) const {
+    // the distances from every source and the words of the search
+    unsigned long long searchBytes =
+        (unsigned long long)nodes.size() *
+            (MULTI_SOURCE_WIDTH + 3 * sizeof(unsigned long long)) +
+        (unsigned long long)getNumMovies() * sizeof(unsigned long long);
+    int maxWorkers = min((unsigned long long)numThreads,
+                         MULTI_SOURCE_MAX_BYTES / searchBytes);
+    if (maxWorkers == 0) {
+        return;
+    }
+
+    // puts the pairs of the same second actor next to each other
+    vector<pair<int, int>> byEnd;  // the second actor and index of each
+    vector<int> starts(ends.size());
+    for (const pair<int, int>& query : queries) {
+        byEnd.emplace_back(ends[query.second], query.second);
+        starts[query.second] = query.first;
+    }
+    sort(byEnd.begin(), byEnd.end());
+    vector<pair<int, int>> groups;  // minus the pairs and the first of each
+    for (unsigned int q = 0; q < byEnd.size(); q++) {
+        if (q == 0 || byEnd[q].first != byEnd[q - 1].first) {
+            groups.emplace_back(0, q);
+        }
+        groups.back().first--;
+    }
+    sort(groups.begin(), groups.end());
+
+    // the second actors with the most pairs are batched first
+    vector<pair<int, int>> batched;  // the pairs of each batch by second actor
+    vector<int> batches(1, 0);       // where each batch begins, then the end
+    unsigned int group = 0;
+    for (; group < groups.size(); group += MULTI_SOURCE_WIDTH) {
+        unsigned int last =
+            min((unsigned int)groups.size(), group + MULTI_SOURCE_WIDTH);
+        int numPairs = 0;
+        for (unsigned int g = group; g < last; g++) {
+            numPairs -= groups[g].first;
+        }
+        if (numPairs < MULTI_SOURCE_MIN_PAIRS) {
+            break;
+        }
+        for (unsigned int g = group; g < last; g++) {
+            batched.insert(batched.end(), byEnd.begin() + groups[g].second,
+                           byEnd.begin() + groups[g].second - groups[g].first);
+        }
+        batches.push_back(batched.size());
+    }
+    queries.clear();
+    for (; group < groups.size(); group++) {
+        for (int q = groups[group].second;
+             q < groups[group].second - groups[group].first; q++) {
+            queries.emplace_back(starts[byEnd[q].second], byEnd[q].second);
+        }
+    }
+
+    int numBatches = batches.size() - 1;
+    int numShards = max(1, min(maxWorkers, numBatches));
+    atomic<int> nextBatch(0);
+    runShards(numShards, [&](int) {
+        SearchContext context;
+        MultiSourceSearch search;
+        vector<int> sources;
+        for (int batch = nextBatch++; batch < numBatches;
+             batch = nextBatch++) {
+            sources.clear();
+            for (int q = batches[batch]; q < batches[batch + 1]; q++) {
+                if (sources.empty() || sources.back() != batched[q].first) {
+                    sources.push_back(batched[q].first);
+                }
+            }
+            bool finished = multiSourceSearch(sources, search);
+
+            int source = -1;  // the row of the pair's second actor
+            for (int q = batches[batch]; q < batches[batch + 1]; q++) {
+                int i = batched[q].second;
+                int start = starts[i];
+                if (q == batches[batch] ||
+                    batched[q].first != batched[q - 1].first) {
+                    source++;
+                }
+                const unsigned char* toEnd =
+                    &search.distances[(size_t)source * nodes.size()];
+                context.begin(nodes.size(), getNumMovies());
+                bool found =
+                    finished ? followDistances(start, ends[i], toEnd, context)
+                             : pairSearch(start, ends[i], false, context);
+                vector<int> path;
+                if (found) {
+                    path = tracePath(ends[i], context);
+                }
+                pathCache.insert(start, ends[i], false, path);
+                paths[i] = move(path);
+            }
+        }
+    });
+}
+
+/*
+ * Calls the visit with every neighbor of the actor and the movie relating
+ * them, in the order the adjacency lists them, opening every movie again for
+ * searches that don't settle actors in order of distance
+ *
+ * Parameters:
+ *              actorId - the actor whose neighbors to visit
+ *              visit - called with the id of each neighbor, the movie id and
+ *                      the movie's weight
+ *
+ * Return: None
+ */
+template <typename Visit>
+void ActorGraph::visitEdges(int actorId, Visit visit) const {
+    if (!bipartite) {
+        for (int edge = adjacency.begin(actorId);
+             edge < adjacency.end(actorId); edge++) {
+            visit(adjacency.neighbors[edge], adjacency.movieIds[edge],
+                  adjacency.weights[edge]);
+        }
+        return;
+    }
+    for (int i = bipartiteAdjacency.moviesBegin(actorId);
+         i < bipartiteAdjacency.moviesEnd(actorId); i++) {
+        int movieId = bipartiteAdjacency.actorMovies[i];
+        int weight = bipartiteAdjacency.movieWeights[movieId];
+        for (int j = bipartiteAdjacency.castBegin(movieId);
+             j < bipartiteAdjacency.castEnd(movieId); j++) {
+            visit(bipartiteAdjacency.movieActors[j], movieId, weight);
+        }
+    }
+}
+
+/*
+ * Calls the visit with every neighbor of the actor and the movie relating
+ * them, in the order the adjacency lists them. Over the actor-movie adjacency
+ * a movie's cast is only visited by the first actor of the side to open it,
+ * every later actor would find the whole cast already reached, so a search
+ * finds the same path over either representation.
+ *
+ * Parameters:
+ *              actorId - the actor whose neighbors to visit
+ *              side - the side of the search doing the visiting
+ *              visit - called with the id of each neighbor, the movie id
+ *                      and the movie's weight
+ *
+ * Return: None
+ */
+template <typename Visit>
+void ActorGraph::visitNeighbors(int actorId, SearchSide& side,
+                                Visit visit) const {
+    if (!bipartite) {
+        visitEdges(actorId, visit);
+        return;
+    }
+
+    // goes through the movies of the actor that haven't been opened yet
+    for (int i = bipartiteAdjacency.moviesBegin(actorId);
+         i < bipartiteAdjacency.moviesEnd(actorId); i++) {
+        int movieId = bipartiteAdjacency.actorMovies[i];
+        if (!side.open(movieId)) {
+            continue;
+        }
+        int weight = bipartiteAdjacency.movieWeights[movieId];
+        for (int j = bipartiteAdjacency.castBegin(movieId);
+             j < bipartiteAdjacency.castEnd(movieId); j++) {
+            visit(bipartiteAdjacency.movieActors[j], movieId, weight);
+        }
+    }
+}
+
+/*
+ * Calls the match with the neighbors of the actor and the movie relating
+ * them, in the order the adjacency lists them, until it returns true
+ *
+ * Parameters:
+ *              actorId - the actor whose neighbors to match
+ *              match - called with the id of each neighbor and the movie id,
+ *                      true to stop
+ *
+ * Return: true if the match stopped at a neighbor, false otherwise
+ */
+template <typename Match>
+bool ActorGraph::findNeighbor(int actorId, Match match) const {
+    if (!bipartite) {
+        for (int edge = adjacency.begin(actorId);
+             edge < adjacency.end(actorId); edge++) {
+            if (match(adjacency.neighbors[edge], adjacency.movieIds[edge])) {
+                return true;
+            }
+        }
+        return false;
+    }
+    for (int i = bipartiteAdjacency.moviesBegin(actorId);
+         i < bipartiteAdjacency.moviesEnd(actorId); i++) {
+        int movieId = bipartiteAdjacency.actorMovies[i];
+        for (int j = bipartiteAdjacency.castBegin(movieId);
+             j < bipartiteAdjacency.castEnd(movieId); j++) {
+            if (match(bipartiteAdjacency.movieActors[j], movieId)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * Tells if a BFS should expand its next level bottom up, which pays off once
+ * the level is large next to the actors left to reach
+ *
+ * Parameters:
+ *              levelSize - the number of actors in the level
+ *              numReached - the number of actors reached so far
+ *              numActors - the number of actors in the graph
+ *
+ * Return: true to expand the level bottom up, false to expand it top down
+ */
+static bool expandBottomUp(int levelSize, int numReached, int numActors) {
+    return (long long)levelSize * BOTTOM_UP_DIVISOR > numActors - numReached;
+}
+
+/*
+ * Expands the deepest level of one side of a bidirectional BFS, queueing the
+ * next level behind it in the order a one way BFS would
+ *
+ * Parameters:
+ *              side - the side to expand
+ *              levelBegin - where the deepest level starts in the side's
+ *                           frontier, moved to where the new level starts
+ *              other - the side searching from the other end
+ *
+ * Return: true if the new level reached an actor the other side reached
+ */
+bool ActorGraph::expandLevel(SearchSide& side, int& levelBegin,
+                             const SearchSide& other) const {
+    int levelEnd = side.frontier.size();
+    bool met = false;
+    for (int head = levelBegin; head < levelEnd; head++) {
+        int curr = side.frontier[head];
+        int distance = side.dist(curr) + 1;
+        visitNeighbors(curr, side, [&](int adj, int movieId, int) {
+            // the actor hasn't been touched, checking for cycles
+            if (!side.reached(adj)) {
+                side.reach(adj, distance, curr, movieId);
+                side.frontier.push_back(adj);
+                met = met || other.reached(adj);
+            }
+        });
+    }
+    levelBegin = levelEnd;
+    return met;
+}
+
+/*
+ * Expands the deepest level of one side of a BFS bottom up: every actor the
+ * side hasn't reached, found a word at a time in a bitmap of the actors it
+ * has, looks through its own neighbors for one in the bitmap of the level
+ * and stops at the first. Once a level covers much of the graph this checks
+ * far fewer edges than expanding the level, but the next level is queued in
+ * order of id rather than in the order a one way BFS would queue it.
+ *
+ * Parameters:
+ *              side - the side to expand, its frontier holding every actor
+ *                     it reached
+ *              levelBegin - where the deepest level starts in the side's
+ *                           frontier, moved to where the new level starts
+ *              other - the side searching from the other end
+ *
+ * Return: true if the new level reached an actor the other side reached
+ */
+bool ActorGraph::expandLevelBottomUp(SearchSide& side, int& levelBegin,
+                                     const SearchSide& other) const {
+    int numActors = nodes.size();
+    int levelEnd = side.frontier.size();
+    int distance = side.dist(side.frontier[levelBegin]) + 1;
+    side.visited.reset(numActors);
+    side.level.reset(numActors);
+    for (int i = 0; i < levelEnd; i++) {
+        side.visited.set(side.frontier[i]);
+    }
+    for (int i = levelBegin; i < levelEnd; i++) {
+        side.level.set(side.frontier[i]);
+    }
+
+    bool met = false;
+    for (int index = 0; index < side.visited.numWords(); index++) {
+        unsigned long long left = ~side.visited.word(index);
+        while (left != 0) {
+            int actorId = index * BITS_PER_WORD + __builtin_ctzll(left);
+            left &= left - 1;
+            if (actorId >= numActors) {
+                break;
+            }
+            findNeighbor(actorId, [&](int adj, int movieId) {
+                if (!side.level.test(adj)) {
+                    return false;
+                }
+                side.reach(actorId, distance, adj, movieId);
+                side.frontier.push_back(actorId);
+                met = met || other.reached(actorId);
+                return true;
+            });
+        }
+    }
+    levelBegin = levelEnd;
+    return met;
+}
+
+/*
+ * Runs a bidirectional BFS from the start and the end, expanding a whole
+ * level of whichever side has the smaller frontier until the sides meet.
+ * The forward side searches in the same order as a one way BFS, so the prev
+ * and connector it leaves behind already match one. Past its deepest level,
+ * only the actors the backward side found on a shortest path are walked in
+ * that same order, so ties break the way a one way BFS breaks them. Only the
+ * backward side's distances are used, so it expands bottom up whenever its
+ * level is large next to the actors it has left. Every way no longer than
+ * the levels of both sides together would already have met, so the search
+ * gives up once they add up to the context's limit.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::unweightedSearch(int start, int end,
+                                  SearchContext& context) const {
+    SearchSide& forward = context;
+    SearchSide& backward = context.backward;
+    backward.begin(nodes.size(), getNumMovies());
+    forward.reach(start, 0, -1, -1);
+    forward.frontier.push_back(start);
+    backward.reach(end, 0, -1, -1);
+    backward.frontier.push_back(end);
+
+    // the first actor of the deepest level of each side
+    int forwardLevel = 0;
+    int backwardLevel = 0;
+    int levels = 0;  // the levels both sides expanded
+    bool met = false;
+    while (!met) {
+        int forwardSize = forward.frontier.size() - forwardLevel;
+        int backwardSize = backward.frontier.size() - backwardLevel;
+
+        // a side ran out of actors, so the two aren't connected, or every
+        // way within the limit was already searched
+        if (forwardSize == 0 || backwardSize == 0 || levels >= context.limit) {
+            return false;
+        }
+        levels++;
+        if (forwardSize <= backwardSize) {
+            met = expandLevel(forward, forwardLevel, backward);
+        } else if (expandBottomUp(backwardSize, backward.frontier.size(),
+                                  nodes.size())) {
+            met = expandLevelBottomUp(backward, backwardLevel, forward);
+        } else {
+            met = expandLevel(backward, backwardLevel, forward);
+        }
+    }
+    if (forward.reached(end)) {
+        context.length = forward.dist(end);
+        return true;
+    }
+
+    // the deepest forward level holds every actor where a shortest path
+    // crosses, the closest to the end of them give its length
+    int level = forward.dist(forward.frontier[forwardLevel]);
+    int remaining = INT_MAX;
+    for (unsigned int i = forwardLevel; i < forward.frontier.size(); i++) {
+        remaining = min(remaining, backward.dist(forward.frontier[i]));
+    }
+    int length = level + remaining;
+    if (!context.tracks()) {
+        context.length = length;
+        return true;
+    }
+
+    // walks on from the crossing actors in queue order, only keeping the
+    // actors that are as far from the end as a shortest path needs
+    vector<int>& crossing = backward.frontier;
+    crossing.clear();
+    for (unsigned int i = forwardLevel; i < forward.frontier.size(); i++) {
+        if (backward.dist(forward.frontier[i]) == remaining) {
+            crossing.push_back(forward.frontier[i]);
+        }
+    }
+    for (unsigned int head = 0; head < crossing.size(); head++) {
+        int curr = crossing[head];
+        int distance = forward.dist(curr) + 1;
+        visitNeighbors(curr, forward, [&](int adj, int movieId, int) {
+            if (!forward.reached(adj) && backward.reached(adj) &&
+                backward.dist(adj) == length - distance) {
+                forward.reach(adj, distance, curr, movieId);
+                crossing.push_back(adj);
+            }
+        });
+        if (forward.reached(end)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Drops the entries at the top of the side's queue left behind by a shorter
+ * way found later, so the top is the next actor to settle
+ *
+ * Parameters:
+ *              side - the side whose queue to look at
+ *
+ * Return: the distance of the next actor to settle, INT_MAX if none are left
+ */
+static int nextDistance(SearchSide& side) {
+    while (!side.queue.empty() && side.done(side.queue.top().actorId)) {
+        side.queue.pop();
+    }
+    return side.queue.empty() ? INT_MAX : side.queue.top().dist;
+}
+
+/*
+ * Settles the next actor of one side of a bidirectional Dijkstra, relaxing
+ * its edges the way a one way Dijkstra would. Every edge leading to an actor
+ * the other side reached is a way through both sides.
+ *
+ * Parameters:
+ *              side - the side to settle, its queue's top must not be stale
+ *              other - the side searching from the other end
+ *              best - the length of the shortest way through both sides,
+ *                     lowered by any shorter one found
+ *
+ * Return: the id of the actor settled
+ */
+int ActorGraph::settleNext(SearchSide& side, const SearchSide& other,
+                           int& best) const {
+    int curr = side.queue.pop().actorId;
+    side.finish(curr);
+
+    int currDist = side.dist(curr);
+    visitNeighbors(curr, side, [&](int adj, int movieId, int weight) {
+        // finds the distance so far including the current neighbor's weight
+        int distance = currDist + weight;
+
+        // shorter distance, better path
+        if (distance < side.dist(adj)) {
+            side.reach(adj, distance, curr, movieId);
+            side.queue.push({distance, nodes[adj]->nameRank, adj});
+        }
+        if (other.reached(adj)) {
+            best = min(best, distance + other.dist(adj));
+        }
+    });
+    return curr;
+}
+
+/*
+ * Runs a bidirectional Dijkstra from the start and the end, settling an
+ * actor of whichever side has the smaller queue until the tops of both
+ * queues add up to no less than the shortest way through both sides. Every
+ * actor nearer the end than the backward side's top is then settled from the
+ * end, which gives the rest of the way exactly. The forward side goes on
+ * settling in the order a one way Dijkstra would, only relaxing the actors
+ * that can still lie on a shortest path, so ties break the way a one way
+ * Dijkstra breaks them. No way left to find is lighter than the two tops
+ * together, so the search gives up once they pass the context's limit.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::weightedSearch(int start, int end,
+                                SearchContext& context) const {
+    SearchSide& forward = context;
+    SearchSide& backward = context.backward;
+    backward.begin(nodes.size(), getNumMovies());
+    forward.reach(start, 0, -1, -1);
+    forward.queue.push({0, nodes[start]->nameRank, start});
+    backward.reach(end, 0, -1, -1);
+    backward.queue.push({0, nodes[end]->nameRank, end});
+
+    // no way through both sides can be shorter than the two tops together
+    int best = INT_MAX;
+    long long forwardTop = 0;
+    long long backwardTop = 0;
+    while (forwardTop + backwardTop < best &&
+           forwardTop + backwardTop <= context.limit) {
+        if (forward.queue.size() <= backward.queue.size()) {
+            // the forward side settles the end the way a one way search does
+            if (settleNext(forward, backward, best) == end) {
+                context.length = forward.dist(end);
+                return true;
+            }
+        } else {
+            settleNext(backward, forward, best);
+        }
+        forwardTop = nextDistance(forward);
+        backwardTop = nextDistance(backward);
+    }
+    if (best == INT_MAX || best > context.limit) {
+        return false;
+    }
+    if (!context.tracks()) {
+        context.length = best;
+        return true;
+    }
+
+    // carries on the forward search through the actors on a shortest path,
+    // which past the forward side are all settled from the end
+    while (!forward.queue.empty()) {
+        int curr = forward.queue.pop().actorId;
+        if (forward.done(curr)) {
+            continue;
+        }
+        forward.finish(curr);
+        if (curr == end) {
+            return true;
+        }
+
+        // the rest of the way is at least the backward side's top
+        int currDist = forward.dist(curr);
+        if (backward.done(curr) ? currDist + backward.dist(curr) != best
+                                : currDist + backwardTop > best) {
+            continue;
+        }
+        visitNeighbors(curr, forward, [&](int adj, int movieId, int weight) {
+            int distance = currDist + weight;
+            bool onPath = adj == end || (backward.done(adj) &&
+                                         distance + backward.dist(adj) == best);
+            if (onPath && distance < forward.dist(adj)) {
+                forward.reach(adj, distance, curr, movieId);
+                forward.queue.push({distance, nodes[adj]->nameRank, adj});
+            }
+        });
+    }
+    return false;
+}
+
+/*
+ * Finds the lower bounds the guide's landmarks give on the weighted distances
+ * from the actor to both ends of the search: by the triangle inequality each
+ * is no less than the difference of their distances from any landmark. The
+ * actor must be connected to the ends.
+ *
+ * Parameters:
+ *              actorId - the actor to bound the distances from
+ *              guide - the landmarks of the search
+ *              toStart - set to the bound on the distance to the start
+ *              toEnd - set to the bound on the distance to the end
+ *
+ * Return: None
+ */
+void ActorGraph::landmarkBounds(int actorId, const LandmarkGuide& guide,
+                                int& toStart, int& toEnd) const {
+    const int* distances =
+        &landmarkDistances[(size_t)actorId * landmarks.size()];
+    toStart = 0;
+    toEnd = 0;
+    for (int i = 0; i < guide.numActive; i++) {
+        int distance = distances[guide.landmarkIndices[i]];
+        toStart = max(toStart, abs(distance - guide.startDistances[i]));
+        toEnd = max(toEnd, abs(distance - guide.endDistances[i]));
+    }
+}
+
+/*
+ * Settles the next actor of one side of a bidirectional A*, relaxing its
+ * edges and queueing each neighbor by twice its distance plus the bound
+ * toward the side's goal less the bound back to its source. Every edge
+ * leading to an actor the other side reached is a way through both sides.
+ *
+ * Parameters:
+ *              side - the side to settle, its queue's top must not be stale
+ *              other - the side searching from the other end
+ *              guide - the landmarks of the search
+ *              fromStart - true for the side searching from the start
+ *              best - the length of the shortest way through both sides,
+ *                     lowered by any shorter one found
+ *
+ * Return: the id of the actor settled
+ */
+int ActorGraph::settleGuided(SearchSide& side, const SearchSide& other,
+                             const LandmarkGuide& guide, bool fromStart,
+                             int& best) const {
+    int curr = side.queue.pop().actorId;
+    side.finish(curr);
+
+    // actors aren't settled in order of distance, so a movie opened by one
+    // actor may still give another a shorter way through it
+    int currDist = side.dist(curr);
+    visitEdges(curr, [&](int adj, int movieId, int weight) {
+        int distance = currDist + weight;
+        if (distance < side.dist(adj)) {
+            if (!side.reached(adj)) {
+                side.frontier.push_back(adj);
+            }
+            side.reach(adj, distance, curr, movieId);
+            int toStart, toEnd;
+            landmarkBounds(adj, guide, toStart, toEnd);
+            int guidance = fromStart ? toEnd - toStart : toStart - toEnd;
+            side.queue.push(
+                {2 * distance + guidance, nodes[adj]->nameRank, adj});
+        }
+        if (other.reached(adj)) {
+            best = min(best, distance + other.dist(adj));
+        }
+    });
+    return curr;
+}
+
+/*
+ * Runs a bidirectional A* from the start and the end, guided by the
+ * landmarks' lower bounds. Each side is ordered by the average of the bounds
+ * toward its goal and away from its source, which keeps the two sides
+ * consistent with each other, so they can stop the way a bidirectional
+ * Dijkstra does and every actor either settles is at its exact distance. The
+ * forward side then goes on settling with the backward side's exact
+ * distances as its bounds, until every actor on a shortest path is settled,
+ * and the path is picked out the way a one way Dijkstra breaks its ties.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::landmarkSearch(int start, int end,
+                                SearchContext& context) const {
+    SearchSide& forward = context;
+    SearchSide& backward = context.backward;
+    LandmarkGuide guide;
+    if (!guideSearch(start, end, guide)) {
+        return false;
+    }
+    int toStart, toEnd;
+    landmarkBounds(start, guide, toStart, toEnd);
+    backward.begin(nodes.size(), getNumMovies());
+    forward.reach(start, 0, -1, -1);
+    forward.frontier.push_back(start);
+    forward.queue.push({toEnd, nodes[start]->nameRank, start});
+    backward.reach(end, 0, -1, -1);
+    backward.queue.push({toEnd, nodes[end]->nameRank, end});
+
+    // the keys are doubled, so no way through both sides can be shorter
+    // than half the two tops together
+    int best = INT_MAX;
+    long long forwardTop = toEnd;
+    long long backwardTop = toEnd;
+    while (forwardTop != INT_MAX && backwardTop != INT_MAX &&
+           forwardTop + backwardTop < 2LL * best &&
+           forwardTop + backwardTop <= 2LL * context.limit) {
+        if (forward.queue.size() <= backward.queue.size()) {
+            settleGuided(forward, backward, guide, true, best);
+        } else {
+            settleGuided(backward, forward, guide, false, best);
+        }
+        forwardTop = nextDistance(forward);
+        backwardTop = nextDistance(backward);
+    }
+    if (best == INT_MAX || best > context.limit) {
+        return false;
+    }
+    if (!context.tracks()) {
+        context.length = best;
+        return true;
+    }
+
+    // the rest of the way from an actor the backward side settled is exact,
+    // from any other it is at least what the backward side's top allows
+    auto rest = [&](int actorId) {
+        if (backward.done(actorId)) {
+            return backward.dist(actorId);
+        }
+        int toStart, toEnd;
+        landmarkBounds(actorId, guide, toStart, toEnd);
+        if (backwardTop == INT_MAX) {
+            return toEnd;
+        }
+        long long twice = backwardTop - toStart + toEnd;
+        return max(toEnd, (int)((twice + 1) / 2));
+    };
+    // goes on from every actor the forward side reached but didn't settle
+    forward.queue.clear();
+    for (int actorId : forward.frontier) {
+        if (!forward.done(actorId)) {
+            forward.queue.push({forward.dist(actorId) + rest(actorId),
+                                nodes[actorId]->nameRank, actorId});
+        }
+    }
+    while (!forward.queue.empty()) {
+        SearchEntry entry = forward.queue.pop();
+        if (entry.dist > best) {
+            break;
+        }
+        int curr = entry.actorId;
+        if (forward.done(curr)) {
+            continue;
+        }
+        forward.finish(curr);
+        if (curr == end) {
+            continue;
+        }
+        int currDist = forward.dist(curr);
+        visitEdges(curr, [&](int adj, int movieId, int weight) {
+            int distance = currDist + weight;
+            if (distance < forward.dist(adj)) {
+                forward.reach(adj, distance, curr, movieId);
+                forward.queue.push(
+                    {distance + rest(adj), nodes[adj]->nameRank, adj});
+            }
+        });
+    }
+    settleTies(start, end, forward);
+    return true;
+}
+
+/*
+ * Points prev and connector along a shortest path from the end back to the
+ * start at what a one way Dijkstra would have left there. A one way Dijkstra
+ * keeps the first actor settled that reaches an actor at its distance, which
+ * is the nearest, then first by name, of the actors a shortest path can come
+ * through, and the first of that actor's lightest movies with it.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              side - the side of a search that settled every actor on a
+ *                     shortest path at its exact distance
+ *
+ * Return: None
+ */
+void ActorGraph::settleTies(int start, int end, SearchSide& side) const {
+    for (int curr = end; curr != start;) {
+        int currDist = side.dist(curr);
+        int prevId = -1;
+        visitEdges(curr, [&](int adj, int, int weight) {
+            if (!side.done(adj) || side.dist(adj) + weight != currDist) {
+                return;
+            }
+            if (prevId == -1 || side.dist(adj) < side.dist(prevId) ||
+                (side.dist(adj) == side.dist(prevId) &&
+                 nodes[adj]->nameRank < nodes[prevId]->nameRank)) {
+                prevId = adj;
+            }
+        });
+
+        int weight = currDist - side.dist(prevId);
+        int connector = -1;
+        visitEdges(prevId, [&](int adj, int movieId, int movieWeight) {
+            if (connector == -1 && adj == curr && movieWeight == weight) {
+                connector = movieId;
+            }
+        });
+        side.reach(curr, currDist, prevId, connector);
+        curr = prevId;
+    }
+}
+
+/*
+ * Settles every node below the core that one side of a hierarchy search
+ * climbs to, leaving the core nodes it reaches on its frontier for the
+ * search inside the core. A node the other side already climbed to is a way
+ * through both sides.
+ *
+ * Parameters:
+ *              side - the side to climb, its end already reached
+ *              other - the side searching from the other end
+ *              best - the length of the lightest way through both sides,
+ *                     lowered by any lighter one found
+ *              meeting - set to the node of the lightest way both sides reach
+ *
+ * Return: None
+ */
+void ActorGraph::climbHierarchy(SearchSide& side, const SearchSide& other,
+                                int& best, int& meeting) const {
+    while (!side.queue.empty()) {
+        int curr = side.queue.pop().actorId;
+        if (side.done(curr)) {
+            continue;
+        }
+        side.finish(curr);
+        int currDist = side.dist(curr);
+        if (other.reached(curr) && currDist + other.dist(curr) < best) {
+            best = currDist + other.dist(curr);
+            meeting = curr;
+        }
+        for (int edge = hierarchy.begin(curr); edge < hierarchy.end(curr);
+             edge++) {
+            int adj = hierarchy.targets[edge];
+            int distance = currDist + hierarchy.weights[edge];
+            if (distance >= side.dist(adj)) {
+                continue;
+            }
+            if (!hierarchy.inCore(adj)) {
+                side.queue.push({distance, 0, adj});
+            } else if (!side.reached(adj)) {
+                side.frontier.push_back(adj);
+            }
+            side.reach(adj, distance, curr, -1);
+        }
+    }
+}
+
+/*
+ * Runs a bidirectional Dijkstra over the contraction hierarchy from the start
+ * and the end. Each side first climbs the edges up to nodes contracted later
+ * until it reaches the core, then the two sides search the core from the core
+ * nodes they reached the way a bidirectional Dijkstra would, stopping once
+ * their tops add up to no less than the lightest way through both sides. The
+ * way is then unpacked into its actors and movies and laid out along prev and
+ * connector. Of several ways equally light the one found isn't always the one
+ * a one way Dijkstra would find.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::hierarchySearch(int start, int end,
+                                 SearchContext& context) const {
+    int numActors = nodes.size();
+    int numNodes = numActors + getNumMovies();
+    SearchSide& forward = context;
+    SearchSide& backward = context.backward;
+    forward.begin(numNodes, getNumMovies());
+    backward.begin(numNodes, getNumMovies());
+
+    int best = INT_MAX;
+    int meeting = -1;  // the node where the lightest way found turns down
+    for (SearchSide* side : {&forward, &backward}) {
+        int from = side == &forward ? start : end;
+        side->reach(from, 0, -1, -1);
+        if (hierarchy.inCore(from)) {
+            side->frontier.push_back(from);
+        } else {
+            side->queue.push({0, 0, from});
+        }
+        climbHierarchy(*side, side == &forward ? backward : forward, best,
+                       meeting);
+    }
+
+    // the core nodes either side reached start its search inside the core,
+    // the emptied queue cleared since they can be nearer than its last key
+    for (SearchSide* side : {&forward, &backward}) {
+        const SearchSide& other = side == &forward ? backward : forward;
+        side->queue.clear();
+        for (int node : side->frontier) {
+            side->queue.push({side->dist(node), 0, node});
+            if (other.reached(node) &&
+                side->dist(node) + other.dist(node) < best) {
+                best = side->dist(node) + other.dist(node);
+                meeting = node;
+            }
+        }
+    }
+    while (true) {
+        int forwardTop = nextDistance(forward);
+        int backwardTop = nextDistance(backward);
+        // a side out of nodes reached every way the other can still meet,
+        // and a way through a node neither side settled yet is no lighter
+        // than the nearer top
+        if (min(forwardTop, backwardTop) >= best ||
+            min(forwardTop, backwardTop) > 2LL * context.limit ||
+            (max(forwardTop, backwardTop) != INT_MAX &&
+             forwardTop + backwardTop >= best)) {
+            break;
+        }
+        bool forwardNext = forwardTop <= backwardTop;
+        SearchSide& side = forwardNext ? forward : backward;
+        const SearchSide& other = forwardNext ? backward : forward;
+        int curr = side.queue.pop().actorId;
+        side.finish(curr);
+        int currDist = side.dist(curr);
+        for (int edge = hierarchy.begin(curr); edge < hierarchy.end(curr);
+             edge++) {
+            int adj = hierarchy.targets[edge];
+            int distance = currDist + hierarchy.weights[edge];
+            if (distance >= side.dist(adj)) {
+                continue;
+            }
+            side.reach(adj, distance, curr, -1);
+            side.queue.push({distance, 0, adj});
+            if (other.reached(adj) && distance + other.dist(adj) < best) {
+                best = distance + other.dist(adj);
+                meeting = adj;
+            }
+        }
+    }
+    if (meeting == -1 || best > 2LL * context.limit) {
+        return false;
+    }
+
+    // the way goes into and out of each of its movies by the movie's weight
+    if (!context.tracks()) {
+        context.length = best / 2;
+        return true;
+    }
+
+    // the nodes climbing from the start to the meeting, then down to the end
+    vector<int> climb;
+    for (int node = meeting; node != -1; node = forward.prev(node)) {
+        climb.push_back(node);
+    }
+    reverse(climb.begin(), climb.end());
+    for (int node = backward.prev(meeting); node != -1;
+         node = backward.prev(node)) {
+        climb.push_back(node);
+    }
+
+    // lays the unpacked way out the way tracePath follows it, every other
+    // node a movie between two actors
+    vector<int> way;
+    for (unsigned int i = 0; i + 1 < climb.size(); i++) {
+        unpackEdge(climb[i], climb[i + 1], way);
+    }
+    forward.begin(numActors, getNumMovies());
+    forward.reach(start, 0, -1, -1);
+    int prevId = start;
+    int distance = 0;
+    for (unsigned int i = 0; i < way.size(); i += 2) {
+        int movieId = way[i] - numActors;
+        distance += bipartiteAdjacency.movieWeights[movieId];
+        forward.reach(way[i + 1], distance, prevId, movieId);
+        prevId = way[i + 1];
+    }
+    return true;
+}
+
+/*
+ * Runs the pruned BFS of one hub of the labels. An actor is left out, along
+ * with every actor past it, once the labels already built give a way between
+ * it and the hub that is as short as the one the BFS found.
+ *
+ * Parameters:
+ *              hub - the id of the actor to search from
+ *              built - the label of every actor built so far
+ *              hubLabel - the hops from the hub to each hub of its label,
+ *                         MAX_LABEL_DISTANCE + 1 where it has none
+ *              side - the actors whose labels get the hub are left on its
+ *                     frontier, each at its distance from the hub
+ *
+ * Return: false if an actor was more than MAX_LABEL_DISTANCE hops from the
+ * hub, true otherwise
+ */
+bool ActorGraph::labelHub(int hub, const vector<vector<LabelEntry>>& built,
+                          const vector<unsigned char>& hubLabel,
+                          SearchSide& side) const {
+    side.begin(nodes.size(), getNumMovies());
+    side.reach(hub, 0, -1, -1);
+    side.frontier.push_back(hub);
+    bool tooFar = false;
+    for (unsigned int head = 0; head < side.frontier.size(); head++) {
+        int curr = side.frontier[head];
+        int distance = side.dist(curr) + 1;
+        visitNeighbors(curr, side, [&](int adj, int movieId, int) {
+            if (side.reached(adj)) {
+                return;
+            }
+            side.reach(adj, distance, curr, movieId);
+
+            // a hub both labels share already gives the distance
+            for (const LabelEntry& entry : built[adj]) {
+                if (hubLabel[entry.hub] + entry.distance <= distance) {
+                    return;
+                }
+            }
+            tooFar = tooFar || distance > MAX_LABEL_DISTANCE;
+            side.frontier.push_back(adj);
+        });
+        if (tooFar) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Searches for the path of one pair. A weighted search goes up the
+ * contraction hierarchy when the graph has one, or is guided by the
+ * landmarks when it has those, and an unweighted one follows the distance
+ * labels when it has them. Otherwise every search runs from both ends. A
+ * context that doesn't track paths only gets the length of the way. A way
+ * longer than the context's limit isn't found, and actors in different
+ * components aren't searched at all.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              useWeighted - use the movie weights instead of hop counts
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::pairSearch(int start, int end, bool useWeighted,
+                            SearchContext& context) const {
+    if (!sameComponent(start, end)) {
+        return false;
+    }
+    bool found;
+    if (!useWeighted) {
+        found = labels.empty() ? unweightedSearch(start, end, context)
+                               : labelSearch(start, end, context);
+    } else if (!hierarchy.empty()) {
+        found = hierarchySearch(start, end, context);
+    } else {
+        found = landmarks.empty() ? weightedSearch(start, end, context)
+                                  : landmarkSearch(start, end, context);
+    }
+
+    // a search stops early past the limit, but can still end on a way just
+    // past it
+    return found && (context.tracks() ? context.dist(end) : context.length) <=
+                        context.limit;
+}
+
+/*
+ * Finds the length of a shortest way between two actors without the path.
+ * The labels give the hops straight away, and any other search stops as
+ * soon as it knows the length, keeping no prev or connector on the way.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              useWeighted - use the movie weights instead of hop counts
+ *              context - the search state to use
+ *
+ * Return: the number of movies or the total weight of the movies on the
+ * way, -1 if the two aren't connected
+ */
+int ActorGraph::pairDistance(int start, int end, bool useWeighted,
+                             SearchContext& context) const {
+    if (start == end) {
+        return 0;
+    }
+    if (!sameComponent(start, end)) {
+        return -1;
+    }
+    if (!useWeighted && !labels.empty()) {
+        int distance = labels.distance(start, end);
+        return distance == INT_MAX || distance > context.limit ? -1 : distance;
+    }
+    context.begin(nodes.size(), getNumMovies());
+    context.trackPaths(false);
+    bool found = pairSearch(start, end, useWeighted, context);
+    context.trackPaths(true);
+    return found ? context.length : -1;
+}
+
+/*
+ * Finds the total weight of the movies on a lightest way between two
+ * actors, the same way shortestWeightedPath searches but without the path
+ *
+ * Parameters:
+ *              firstActor - the name of the first actor
+ *              secondActor - the name of the second actor
+ *
+ * Return: the total weight of the way, -1 if an actor doesn't exist or
+ * they aren't connected
+ */
+int ActorGraph::weightedDistance(const string& firstActor,
+                                 const string& secondActor) const {
+    int firstId = actorNames.find(firstActor);
+    int secondId = actorNames.find(secondActor);
+    if (firstId == -1 || secondId == -1) {
+        return -1;
+    }
+    return pairDistance(firstId, secondId, true, threadContext());
+}
+
+/*
+ * Finds the length of a shortest way between every pair on all of the
+ * graph's threads, without the paths. The pairs are handed out a block at a
+ * time as threads free up, each thread searching with a context of its own.
+ *
+ * Parameters:
+ *              pairs - the first and second actor of each search
+ *              useWeighted - use the movie weights instead of hop counts
+ *
+ * Return: the number of movies or total weight between each pair in the
+ * order of the pairs, -1 where an actor doesn't exist or the two aren't
+ * connected
+ */
+vector<int> ActorGraph::shortestDistances(
+    const vector<pair<string, string>>& pairs, bool useWeighted) const {
+    vector<int> distances(pairs.size(), -1);
+    int numBlocks = (pairs.size() + DISTANCE_BLOCK - 1) / DISTANCE_BLOCK;
+    int numShards = max(1, min((int)numThreads, numBlocks));
+    atomic<int> nextBlock(0);
+    runShards(numShards, [&](int) {
+        SearchContext context;
+        for (int block = nextBlock++; block < numBlocks; block = nextBlock++) {
+            int last = min((int)pairs.size(), (block + 1) * DISTANCE_BLOCK);
+            for (int i = block * DISTANCE_BLOCK; i < last; i++) {
+                int firstId = actorNames.find(pairs[i].first);
+                int secondId = actorNames.find(pairs[i].second);
+                if (firstId != -1 && secondId != -1) {
+                    distances[i] =
+                        pairDistance(firstId, secondId, useWeighted, context);
+                }
+            }
+        }
+    });
+    return distances;
+}
+
+/*
+ * Runs a one way BFS or Dijkstra from the start until every target is found,
+ * leaving prev and connector on every actor reached the way a search to each
+ * target alone would
+ *
+ * Parameters:
+ *              start - the id of the actor to search from
+ *              targets - the ids of the actors to find, without repeats or
+ *                        the start, none to search every actor the start
+ *                        reaches
+ *              useWeighted - use the movie weights instead of hop counts
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached, the targets reached are final
+ *
+ * Return: None
+ */
+void ActorGraph::searchFrom(int start, const vector<int>& targets,
+                            bool useWeighted, SearchContext& context) const {
+    SearchSide& forward = context;
+
+    // the backward side marks the targets, which no search reaches
+    SearchSide& marks = context.backward;
+    marks.begin(nodes.size(), getNumMovies());
+    for (int target : targets) {
+        marks.finish(target);
+    }
+    int remaining = targets.empty() ? -1 : targets.size();
+    forward.reach(start, 0, -1, -1);
+
+    if (!useWeighted) {
+        forward.frontier.push_back(start);
+        for (unsigned int head = 0;
+             head < forward.frontier.size() && remaining != 0; head++) {
+            int curr = forward.frontier[head];
+            int distance = forward.dist(curr) + 1;
+            visitNeighbors(curr, forward, [&](int adj, int movieId, int) {
+                if (!forward.reached(adj)) {
+                    forward.reach(adj, distance, curr, movieId);
+                    forward.frontier.push_back(adj);
+                    remaining -= marks.done(adj);
+                }
+            });
+        }
+        return;
+    }
+
+    // a target reached is only final once it is settled, the queue running
+    // out settles every actor reached
+    int unused = INT_MAX;
+    forward.queue.push({0, nodes[start]->nameRank, start});
+    while (remaining != 0 && nextDistance(forward) != INT_MAX) {
+        remaining -= marks.done(settleNext(forward, marks, unused));
+    }
+}
+
+/*
+ * Splits the work into as many shards as the threads, but no more than gives
+ * each SHARD_MIN_ACTORS actors, since starting a thread costs about as much
+ * as that many actors take
+ *
+ * Parameters:
+ *              numActors - the number of actors to split
+ *              numThreads - the number of threads there are
+ *
+ * Return: the number of shards, at least one
+ */
+static int numShardsFor(int numActors, unsigned int numThreads) {
+    return max(1, min((int)numThreads, numActors / SHARD_MIN_ACTORS));
+}
+
+/*
+ * Lowers the value to the given one if that is lower, even while other
+ * threads lower it too
+ *
+ * Parameters:
+ *              value - the value to lower
+ *              lower - the value to lower it to
+ *
+ * Return: true if this call lowered it
+ */
+static bool lowerTo(atomic<int>& value, int lower) {
+    int current = value.load(memory_order_relaxed);
+    while (lower < current) {
+        if (value.compare_exchange_weak(current, lower,
+                                        memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Runs a level synchronous BFS from the start over every actor it reaches,
+ * on all of the graph's threads. Each level is split among the threads,
+ * expanded top down while it is small, each movie opened by the first thread
+ * to reach it and each actor claimed by the first to reach it, and bottom up
+ * once it is large next to the actors left, each thread looking through its
+ * own range of the actors not reached.
+ *
+ * Parameters:
+ *              start - the id of the actor to search from
+ *              distances - set to the hops to every actor, -1 where it
+ *                          doesn't reach
+ *
+ * Return: None
+ */
+void ActorGraph::parallelBFS(int start,
+                             vector<atomic<int>>& distances) const {
+    const BipartiteAdjacency& index = bipartiteAdjacency;
+    int numActors = nodes.size();
+    for (atomic<int>& distance : distances) {
+        distance.store(-1, memory_order_relaxed);
+    }
+    vector<atomic<bool>> opened(getNumMovies());
+    for (atomic<bool>& movie : opened) {
+        movie.store(false, memory_order_relaxed);
+    }
+
+    distances[start].store(0, memory_order_relaxed);
+    vector<int> level(1, start);
+    int numReached = 1;
+    for (int depth = 0; !level.empty(); depth++) {
+        bool bottomUp = expandBottomUp(level.size(), numReached, numActors);
+        int numShards =
+            numShardsFor(bottomUp ? numActors : level.size(), numThreads);
+        vector<vector<int>> found(numShards);  // the next level by shard
+        runShards(numShards, [&](int shard) {
+            int size = bottomUp ? numActors : level.size();
+            int first = (long long)size * shard / numShards;
+            int last = (long long)size * (shard + 1) / numShards;
+            if (bottomUp) {
+                // an actor not reached looks for a neighbor in the level
+                for (int actorId = first; actorId < last; actorId++) {
+                    if (distances[actorId].load(memory_order_relaxed) != -1) {
+                        continue;
+                    }
+                    bool inLevel = false;
+                    for (int i = index.moviesBegin(actorId);
+                         i < index.moviesEnd(actorId) && !inLevel; i++) {
+                        int movieId = index.actorMovies[i];
+                        for (int j = index.castBegin(movieId);
+                             j < index.castEnd(movieId) && !inLevel; j++) {
+                            inLevel = distances[index.movieActors[j]].load(
+                                          memory_order_relaxed) == depth;
+                        }
+                    }
+                    if (inLevel) {
+                        distances[actorId].store(depth + 1,
+                                                 memory_order_relaxed);
+                        found[shard].push_back(actorId);
+                    }
+                }
+                return;
+            }
+
+            // every movie of the level is opened once, by whichever thread
+            // gets to it first, and its cast not reached joins the next level
+            for (int k = first; k < last; k++) {
+                int curr = level[k];
+                for (int i = index.moviesBegin(curr);
+                     i < index.moviesEnd(curr); i++) {
+                    int movieId = index.actorMovies[i];
+                    if (opened[movieId].exchange(true, memory_order_relaxed)) {
+                        continue;
+                    }
+                    for (int j = index.castBegin(movieId);
+                         j < index.castEnd(movieId); j++) {
+                        int adj = index.movieActors[j];
+                        int unreached = -1;
+                        if (distances[adj].load(memory_order_relaxed) == -1 &&
+                            distances[adj].compare_exchange_strong(
+                                unreached, depth + 1, memory_order_relaxed)) {
+                            found[shard].push_back(adj);
+                        }
+                    }
+                }
+            }
+        });
+        level.clear();
+        for (const vector<int>& shardFound : found) {
+            level.insert(level.end(), shardFound.begin(), shardFound.end());
+        }
+        numReached += level.size();
+    }
+}
+
+/*
+ * Runs a delta stepping search from the start over every actor it reaches,
+ * on all of the graph's threads. The actors wait in buckets DELTA_STEP_WIDTH
+ * wide by distance, and the lightest bucket is emptied by relaxing the light
+ * movies of all of its actors at once, over and over until none come back to
+ * it, then their heavy movies once. A movie is only gone through again by an
+ * actor nearer than the last one.
+ *
+ * Parameters:
+ *              start - the id of the actor to search from
+ *              distances - set to the total weight to every actor, -1 where
+ *                          it doesn't reach
+ *
+ * Return: None
+ */
+void ActorGraph::deltaStepping(int start,
+                               vector<atomic<int>>& distances) const {
+    const BipartiteAdjacency& index = bipartiteAdjacency;
+    int numActors = nodes.size();
+    for (atomic<int>& distance : distances) {
+        distance.store(INT_MAX, memory_order_relaxed);
+    }
+    vector<atomic<int>> openedAt(getNumMovies());  // the nearest to open it
+    for (atomic<int>& movie : openedAt) {
+        movie.store(INT_MAX, memory_order_relaxed);
+    }
+    vector<int> relaxedAt(numActors, -1);  // the distance last relaxed from
+    vector<int> settledIn(numActors, -1);  // the bucket it was settled in
+
+    // relaxes the light or the heavy movies of each actor, every thread
+    // keeping the actors it brought nearer
+    vector<vector<int>> buckets(1, vector<int>(1, start));
+    distances[start].store(0, memory_order_relaxed);
+    auto relax = [&](const vector<int>& actors, bool light) {
+        int numShards = numShardsFor(actors.size(), numThreads);
+        vector<vector<int>> nearer(numShards);
+        runShards(numShards, [&](int shard) {
+            int first = (long long)actors.size() * shard / numShards;
+            int last = (long long)actors.size() * (shard + 1) / numShards;
+            for (int k = first; k < last; k++) {
+                int curr = actors[k];
+                int currDist = distances[curr].load(memory_order_relaxed);
+                for (int i = index.moviesBegin(curr);
+                     i < index.moviesEnd(curr); i++) {
+                    int movieId = index.actorMovies[i];
+                    int weight = index.movieWeights[movieId];
+                    if ((weight <= DELTA_STEP_WIDTH) != light ||
+                        !lowerTo(openedAt[movieId], currDist)) {
+                        continue;
+                    }
+                    for (int j = index.castBegin(movieId);
+                         j < index.castEnd(movieId); j++) {
+                        int adj = index.movieActors[j];
+                        if (lowerTo(distances[adj], currDist + weight)) {
+                            nearer[shard].push_back(adj);
+                        }
+                    }
+                }
+            }
+        });
+        for (const vector<int>& shardNearer : nearer) {
+            for (int adj : shardNearer) {
+                unsigned int bucket =
+                    distances[adj].load(memory_order_relaxed) /
+                    DELTA_STEP_WIDTH;
+                if (bucket >= buckets.size()) {
+                    buckets.resize(bucket + 1);
+                }
+                buckets[bucket].push_back(adj);
+            }
+        }
+    };
+
+    vector<int> current;
+    vector<int> settled;
+    for (unsigned int bucket = 0; bucket < buckets.size(); bucket++) {
+        settled.clear();
+        while (!buckets[bucket].empty()) {
+            // drops the actors brought nearer since they were added or
+            // already relaxed at their distance
+            current.clear();
+            for (int actorId : buckets[bucket]) {
+                int distance = distances[actorId].load(memory_order_relaxed);
+                if ((unsigned int)distance / DELTA_STEP_WIDTH == bucket &&
+                    relaxedAt[actorId] != distance) {
+                    relaxedAt[actorId] = distance;
+                    current.push_back(actorId);
+                    if (settledIn[actorId] != (int)bucket) {
+                        settledIn[actorId] = bucket;
+                        settled.push_back(actorId);
+                    }
+                }
+            }
+            vector<int>().swap(buckets[bucket]);
+            relax(current, true);
+        }
+
+        // the distances of the bucket are final, so its heavy movies only
+        // need going through once
+        relax(settled, false);
+    }
+    for (atomic<int>& distance : distances) {
+        if (distance.load(memory_order_relaxed) == INT_MAX) {
+            distance.store(-1, memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * Picks the actor and movie each actor is reached through on a shortest path
+ * from the source: the first neighbor, in the order of the actor's movies and
+ * their casts, whose distance and the movie add up to the actor's. The actors
+ * are split among the graph's threads.
+ *
+ * Parameters:
+ *              useWeighted - use the movie weights instead of hop counts
+ *              result - holds the distance to every actor, previous and
+ *                       connectors are set
+ *
+ * Return: None
+ */
+void ActorGraph::findPrevious(bool useWeighted, ActorDistances& result) const {
+    const BipartiteAdjacency& index = bipartiteAdjacency;
+    const vector<int>& distances = result.distances;
+    int numActors = nodes.size();
+    result.previous.assign(numActors, -1);
+    result.connectors.assign(numActors, -1);
+    int numShards = numShardsFor(numActors, numThreads);
+    runShards(numShards, [&](int shard) {
+        int first = (long long)numActors * shard / numShards;
+        int last = (long long)numActors * (shard + 1) / numShards;
+        for (int actorId = first; actorId < last; actorId++) {
+            if (distances[actorId] <= 0) {
+                continue;
+            }
+            for (int i = index.moviesBegin(actorId);
+                 i < index.moviesEnd(actorId) && result.previous[actorId] == -1;
+                 i++) {
+                int movieId = index.actorMovies[i];
+                int weight = useWeighted ? index.movieWeights[movieId] : 1;
+                for (int j = index.castBegin(movieId);
+                     j < index.castEnd(movieId); j++) {
+                    int adj = index.movieActors[j];
+                    if (distances[adj] != -1 &&
+                        distances[adj] + weight == distances[actorId]) {
+                        result.previous[actorId] = adj;
+                        result.connectors[actorId] = movieId;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+}
+
+/*
+ * Runs a bit-parallel BFS from up to MULTI_SOURCE_WIDTH actors at once, one
+ * bit of every actor's words for each of them. Each level is expanded for
+ * every source with one pass over the edges, through the movies over the
+ * actor-movie adjacency, and the bits new to an actor give its distance from
+ * those sources.
+ *
+ * Parameters:
+ *              sources - the ids of the actors to search from
+ *              search - holds the distance from each source to every actor
+ *
+ * Return: false if an actor was more than MULTI_SOURCE_UNREACHED - 1 hops
+ * from a source, which leaves the distances unfinished, true otherwise
+ */
+bool ActorGraph::multiSourceSearch(const vector<int>& sources,
+                                   MultiSourceSearch& search) const {
+    int numActors = nodes.size();
+    search.seen.assign(numActors, 0);
+    search.visit.assign(numActors, 0);
+    search.next.assign(numActors, 0);
+    search.movies.assign(bipartite ? getNumMovies() : 0, 0);
+    search.distances.assign((size_t)sources.size() * numActors,
+                            MULTI_SOURCE_UNREACHED);
+    for (unsigned int i = 0; i < sources.size(); i++) {
+        search.seen[sources[i]] |= 1ULL << i;
+        search.visit[sources[i]] |= 1ULL << i;
+        search.distances[(size_t)i * numActors + sources[i]] = 0;
+    }
+
+    bool expanding = true;
+    for (int level = 1; expanding; level++) {
+        if (level == MULTI_SOURCE_UNREACHED) {
+            return false;
+        }
+
+        // every source of an actor's level reaches each of its neighbors,
+        // over the actor-movie adjacency by way of their movies
+        for (int actorId = 0; actorId < numActors; actorId++) {
+            unsigned long long visit = search.visit[actorId];
+            if (visit == 0) {
+                continue;
+            }
+            if (!bipartite) {
+                for (int edge = adjacency.begin(actorId);
+                     edge < adjacency.end(actorId); edge++) {
+                    search.next[adjacency.neighbors[edge]] |= visit;
+                }
+                continue;
+            }
+            for (int i = bipartiteAdjacency.moviesBegin(actorId);
+                 i < bipartiteAdjacency.moviesEnd(actorId); i++) {
+                search.movies[bipartiteAdjacency.actorMovies[i]] |= visit;
+            }
+        }
+        for (unsigned int movieId = 0; movieId < search.movies.size();
+             movieId++) {
+            unsigned long long visit = search.movies[movieId];
+            if (visit == 0) {
+                continue;
+            }
+            for (int j = bipartiteAdjacency.castBegin(movieId);
+                 j < bipartiteAdjacency.castEnd(movieId); j++) {
+                search.next[bipartiteAdjacency.movieActors[j]] |= visit;
+            }
+            search.movies[movieId] = 0;
+        }
+
+        // the sources new to an actor make up its next level
+        expanding = false;
+        for (int actorId = 0; actorId < numActors; actorId++) {
+            unsigned long long found =
+                search.next[actorId] & ~search.seen[actorId];
+            search.next[actorId] = 0;
+            search.visit[actorId] = found;
+            search.seen[actorId] |= found;
+            expanding = expanding || found != 0;
+            while (found != 0) {
+                int i = __builtin_ctzll(found);
+                found &= found - 1;
+                search.distances[(size_t)i * numActors + actorId] = level;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Walks a one way BFS from the start toward the end, only queueing the
+ * actors one hop closer to the end, in the order a one way BFS would queue
+ * them. Every actor the BFS would reach the end through is kept, so prev and
+ * connector break ties the way a one way BFS breaks them.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              toEnd - the hops from every actor to the end,
+ *                      MULTI_SOURCE_UNREACHED where it doesn't reach
+ *              context - holds the distance, prev and connector of every
+ *                        actor reached
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::followDistances(int start, int end,
+                                 const unsigned char* toEnd,
+                                 SearchContext& context) const {
+    int length = toEnd[start];
+    if (length == MULTI_SOURCE_UNREACHED) {
+        return false;
+    }
+    context.reach(start, 0, -1, -1);
+    context.frontier.push_back(start);
+    for (unsigned int head = 0; head < context.frontier.size(); head++) {
+        int curr = context.frontier[head];
+        int distance = context.dist(curr) + 1;
+        visitNeighbors(curr, context, [&](int adj, int movieId, int) {
+            if (!context.reached(adj) && toEnd[adj] == length - distance) {
+                context.reach(adj, distance, curr, movieId);
+                context.frontier.push_back(adj);
+            }
+        });
+        if (context.reached(end)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Follows prev back from the end of a search to its start, collecting each
+ * actor and connecting movie along the way
+ *
+ * Parameters:
+ *              end - the id of the actor the search stopped at
+ *              context - the state the search left behind
+ *
+ * Return: the ids along the path from the end back to the start, alternating
+ * between actor ids and movie ids
+ */
+vector<int> ActorGraph::tracePath(int end,
+                                  const SearchContext& context) const {
+    vector<int> path;
+
+    // forms the path from the end to the start using a vector
+    while (context.prev(end) != -1) {
+        path.push_back(end);
+        path.push_back(context.connector(end));
+        end = context.prev(end);
+    }
+    path.push_back(end);
+    return path;
+}
+
+/*
+ * Formats each actor and movie of a traced path
+ *
+ * Parameters:
+ *              path - the ids along the path, alternating between actor ids
+ *                     and movie ids
+ *
+ * Return: the names of the actors and the formatted movies in the same order
+ */
+vector<string> ActorGraph::formatPath(const vector<int>& path) const {
+    vector<string> formatted;
+    formatted.reserve(path.size());
+    for (unsigned int i = 0; i < path.size(); i++) {
+        formatted.push_back(i % 2 == 0 ? actorNames.name(path[i])
+                                       : formatMovie(path[i]));
+    }
+    return formatted;
+}
+
+/*
+ * Finds the id of the movie, giving the movie the next id the first time its
+ * title and year are seen together
+ *
+ * Parameters:
+ *              movieTitle - the first character of the movie's title
+ *              length - the number of characters in the title
+ *              titleHash - the hash of the title
+ *              year - the year of the movie
+ *
+ * Return: the id of the movie
+ */
+int ActorGraph::internMovie(const char* movieTitle, size_t length,
+                            unsigned int titleHash, int year) {
+    int titleId = movieTitles.intern(movieTitle, length, titleHash);
+    long long key = ((long long)titleId << 32) | (unsigned int)year;
+    auto inserted = movieIds.emplace(key, (int)movieCasts.size());
+    if (inserted.second) {
+        movieTitleIds.edit().push_back(titleId);
+        movieYears.edit().push_back(year);
+        movieCasts.emplace_back();
+    }
+    return inserted.first->second;
+}
+
+/*
+ * Parses the year column the way stoi would: leading spaces, an optional sign
+ * then digits, ignoring whatever follows them such as a carriage return
+ *
+ * Parameters:
+ *              first - the first character of the column
+ *              last - one past the last character of the column
+ *              year - set to the parsed value
+ *
+ * Return: true if the column starts with a number, false otherwise
+ */
+static bool parseYear(const char* first, const char* last, int& year) {
+    while (first != last && isspace((unsigned char)*first)) {
+        first++;
+    }
+    bool negative = false;
+    if (first != last && (*first == '-' || *first == '+')) {
+        negative = *first == '-';
+        first++;
+    }
+    if (first == last || !isdigit((unsigned char)*first)) {
+        return false;
+    }
+    int value = 0;
+    while (first != last && isdigit((unsigned char)*first)) {
+        value = value * 10 + (*first - '0');
+        first++;
+    }
+    year = negative ? -value : value;
+    return true;
+}
+
+/*
+ * Splits the lines of one chunk of the movie cast file into rows, skipping
+ * any line without exactly three columns or without a year. The strings stay
+ * in the mapped file, only where they start and their hashes are kept.
+ *
+ * Parameters:
+ *              first - the first character of the chunk, the start of a line
+ *              last - one past the last character of the chunk
+ *              rows - collects the rows of the chunk in the order read
+ *
+ * Return: None
+ */
+static void parseCastRows(const char* first, const char* last,
+                          vector<CastRow>& rows) {
+    const char* cursor = first;
+    while (cursor != last) {
+        const char* lineEnd =
+            (const char*)memchr(cursor, '\n', last - cursor);
+        if (lineEnd == NULL) {
+            lineEnd = last;
+        }
+        const char* line = cursor;
+        cursor = lineEnd == last ? last : lineEnd + 1;
+
+        // splits the line on tabs, a tab ending the line adds no column
+        const char* columns[COLUMNS_PER_LINE + 1];
+        int numColumns = 0;
+        const char* column = line;
+        while (column != lineEnd && numColumns <= COLUMNS_PER_LINE) {
+            const char* tab =
+                (const char*)memchr(column, '\t', lineEnd - column);
+            columns[numColumns++] = column;
+            column = tab == NULL ? lineEnd : tab + 1;
+            if (tab == NULL) {
+                break;
+            }
+        }
+
+        if (numColumns != COLUMNS_PER_LINE) {
+            // we should have exactly 3 columns
+            continue;
+        }
+
+        // each column runs up to the tab before the next one
+        CastRow row;
+        if (!parseYear(columns[THIRD_COLUMN], lineEnd, row.year)) {
+            continue;
+        }
+        row.actor = columns[0];
+        row.actorLength = columns[1] - 1 - row.actor;
+        row.actorHash = StringInterner::hash(row.actor, row.actorLength);
+        row.title = columns[1];
+        row.titleLength = columns[THIRD_COLUMN] - 1 - row.title;
+        row.titleHash = StringInterner::hash(row.title, row.titleLength);
+        rows.push_back(row);
+    }
+}
+
+/** You can modify this method definition as you wish
+ *
+ * Load the graph from a tab-delimited file of actor->movie
  * relationships. The nadd the actor to a graph and the actor to the movie it's
- * currently at.
+ * currently at, interning both so the rest of the graph only sees ids. The
+ * file is split at line breaks into one chunk per thread, the chunks are
+ * parsed at the same time, then their rows are interned in file order so the
+ * ids are the same for any number of threads.
  *
  * in_filename - input filename
  * use_weighted_edges - if true, compute edge weights as 1 + (2019 -
@@ -517,65 +3161,232 @@ vector<string> ActorGraph::shortestUnweightedPath(string firstActor,
  */
 bool ActorGraph::loadFromFile(const char* in_filename,
                               bool use_weighted_edges) {
-    // Initialize the file stream
-    ifstream infile(in_filename);
-
-    bool have_header = false;
+    // maps the file so every column is read in place without copying lines
+    MappedFile infile;
+    if (!infile.open(in_filename)) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+    infile.adviseSequential();
+
+    // skip the header
+    const char* fileEnd = infile.data() + infile.size();
+    const char* body = infile.data() == NULL
+                           ? NULL
+                           : (const char*)memchr(infile.data(), '\n',
+                                                 infile.size());
+    body = body == NULL ? fileEnd : body + 1;
+
+    // small files aren't worth starting threads for
+    size_t bodySize = fileEnd - body;
+    size_t numChunks = min((size_t)numThreads,
+                           max((size_t)1, bodySize / MIN_CHUNK_BYTES));
+
+    // moves each split point forward to the start of the next line
+    vector<const char*> bounds(numChunks + 1, fileEnd);
+    bounds[0] = body;
+    for (size_t chunk = 1; chunk < numChunks; chunk++) {
+        const char* split = body + bodySize / numChunks * chunk;
+        split = max(split, bounds[chunk - 1]);
+        const char* lineEnd =
+            (const char*)memchr(split, '\n', fileEnd - split);
+        bounds[chunk] = lineEnd == NULL ? fileEnd : lineEnd + 1;
+    }
 
-    // keep reading lines until the end of file is reached
-    while (infile) {
-        string s;
+    vector<vector<CastRow>> rows(numChunks);
+    vector<thread> workers;
+    for (size_t chunk = 1; chunk < numChunks; chunk++) {
+        workers.emplace_back(parseCastRows, bounds[chunk], bounds[chunk + 1],
+                             ref(rows[chunk]));
+    }
+    parseCastRows(bounds[0], bounds[1], rows[0]);
+    for (thread& worker : workers) {
+        worker.join();
+    }
 
-        // get the next line
-        if (!getline(infile, s)) break;
+    // interns the rows in the order of the file
+    for (const vector<CastRow>& chunkRows : rows) {
+        for (const CastRow& row : chunkRows) {
+            // if the actor doesn't exist, then add to the graph
+            int actorId =
+                actorNames.intern(row.actor, row.actorLength, row.actorHash);
+            if (actorId == (int)nodes.size()) {
+                nodes.push_back(new ActorNode(actorId));
+            }
 
-        if (!have_header) {
-            // skip the header
-            have_header = true;
-            continue;
+            // add the actor to the movie
+            int movieId = internMovie(row.title, row.titleLength,
+                                      row.titleHash, row.year);
+            movieCasts[movieId].push_back(actorId);
         }
+    }
 
-        istringstream ss(s);
-        vector<string> record;
-
-        while (ss) {
-            string str;
+    return true;
+}
 
-            // get the next string before hitting a tab character
-            // and put it in 'str'
-            if (!getline(ss, str, '\t')) break;
-            record.push_back(str);
+/*
+ * Adds rows of the same three columns as the movie cast file to the graph.
+ * Before the graph is built they only join the casts like the rows of the
+ * file. Once it is built, only the rows' movies and actors are updated: the
+ * new edges go after each actor's existing ones, the neighbor counts and
+ * lightest movies are updated in place and new actors are merged into the
+ * name ranks. Each new role joins the component of its movie's cast, so the
+ * cost grows with the rows rather than the graph.
+ *
+ * Parameters:
+ *              rows - the actor, movie title and year of each new row
+ *
+ * Return: None
+ */
+void ActorGraph::ingest(const vector<ActorMovieRow>& rows) {
+    bool built = !bipartiteAdjacency.actorOffsets.empty();
+    if (built) {
+        restoreMovieCasts();
+    }
+    int firstNewActor = nodes.size();
+
+    for (const ActorMovieRow& row : rows) {
+        int actorId = actorNames.intern(row.actor);
+        if (actorId == (int)nodes.size()) {
+            nodes.push_back(new ActorNode(actorId));
+            if (built) {
+                bipartiteAdjacency.addActor();
+                if (!bipartite) {
+                    adjacency.addActor();
+                }
+            }
         }
 
-        if (record.size() != 3) {
-            // we should have exactly 3 columns
+        int numMovies = movieCasts.size();
+        int movieId = internMovie(
+            row.movieTitle.data(), row.movieTitle.size(),
+            StringInterner::hash(row.movieTitle.data(), row.movieTitle.size()),
+            row.year);
+        movieCasts[movieId].push_back(actorId);
+        if (!built) {
             continue;
         }
+        if (movieId == numMovies) {
+            bipartiteAdjacency.addMovie(edgeWeight(row.year));
+        }
+        linkRole(actorId, movieId);
+    }
 
-        string actor(record[0]);
-        string movie_title(record[1]);
-        int year = stoi(record[THIRD_COLUMN]);
+    if (!built) {
+        return;
+    }
+    if ((int)nodes.size() > firstNewActor) {
+        rankNewActors(firstNewActor);
+    }
 
-        // if the actor doesn't exist, then add to the graph
-        ActorNode* actorNode;
-        if (graph.find(actor) == graph.end()) {
-            graph[actor] = new ActorNode(actor, movie_title, year);
+    // new movies can shorten any path and new names shift the ties, which
+    // leaves the landmarks' distances too long to bound a search by, the
+    // hierarchy without the shortcuts the new movies need and the labels
+    // missing the hubs of the new ways
+    pathCache.clear();
+    buildLandmarks(0);
+    hierarchy.clear();
+    labels.clear();
+
+    // packs the rows once the gaps left by moving them outgrow the entries
+    if (adjacency.sparse()) {
+        adjacency.pack();
+    }
+    if (bipartiteAdjacency.sparse()) {
+        bipartiteAdjacency.pack();
+    }
+}
 
-        } else {
-            // the NULL represents the to-be connections, later found
-            // when building the graph
-            graph[actor]->edges[movie_title][year].push_back(NULL);
+/*
+ * Relates the actor just added to the end of the movie's cast to the rest of
+ * the cast, the same way building the graph would have
+ *
+ * Parameters:
+ *              actorId - the actor added to the cast
+ *              movieId - the movie the actor was added to
+ *
+ * Return: None
+ */
+void ActorGraph::linkRole(int actorId, int movieId) {
+    bipartiteAdjacency.addRole(actorId, movieId);
+    const vector<int>& cast = movieCasts[movieId];
+    int weight = bipartiteAdjacency.movieWeights[movieId];
+    ActorNode* actor = nodes[actorId];
+    joinComponents(cast.front(), actorId);
+
+    // everyone already in the cast comes before the actor
+    for (unsigned int i = 0; i + 1 < cast.size(); i++) {
+        ActorNode* other = nodes[cast[i]];
+        if (!bipartite) {
+            adjacency.addEdge(cast[i], actorId, movieId, weight);
+            adjacency.addEdge(actorId, cast[i], movieId, weight);
+        }
+        if (neighborMapsBuilt) {
+            other->neighbors[actor] += 1;
+            actor->neighbors[other] += 1;
+        }
+        if (weightedMapsBuilt) {
+            linkLightestMovie(other, actor, movieId, weight);
         }
-
-        // add the actor to the movie
-        movies[movie_title][year].push_back(graph[actor]);
     }
+}
 
-    if (!infile.eof()) {
-        cerr << "Failed to read " << in_filename << "!\n";
-        return false;
+/*
+ * Merges the actors added since the last ranking into the name ranks without
+ * sorting every name again
+ *
+ * Parameters:
+ *              firstNewActor - the id of the first actor added
+ *
+ * Return: None
+ */
+void ActorGraph::rankNewActors(int firstNewActor) {
+    vector<int> ranked(firstNewActor);
+    for (int actorId = 0; actorId < firstNewActor; actorId++) {
+        ranked[nodes[actorId]->nameRank] = actorId;
     }
-    infile.close();
+    vector<int> added;
+    for (unsigned int actorId = firstNewActor; actorId < nodes.size();
+         actorId++) {
+        added.push_back(actorId);
+    }
+    auto byName = [this](int lhs, int rhs) {
+        return actorNames.less(lhs, rhs);
+    };
+    sort(added.begin(), added.end(), byName);
+
+    vector<int> merged(nodes.size());
+    merge(ranked.begin(), ranked.end(), added.begin(), added.end(),
+          merged.begin(), byName);
+    for (unsigned int rank = 0; rank < merged.size(); rank++) {
+        nodes[merged[rank]]->nameRank = rank;
+    }
+}
 
-    return true;
+/*
+ * Gives a graph mapped from a snapshot back the cast of each movie and the
+ * ids of the movies by title and year, which the snapshot leaves out since
+ * only ingest needs them
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void ActorGraph::restoreMovieCasts() {
+    int numMovies = movieYears.size();
+    if ((int)movieCasts.size() == numMovies) {
+        return;
+    }
+    movieCasts.assign(numMovies, vector<int>());
+    movieIds.clear();
+    for (int movieId = 0; movieId < numMovies; movieId++) {
+        movieCasts[movieId].assign(
+            bipartiteAdjacency.movieActors.begin() +
+                bipartiteAdjacency.castBegin(movieId),
+            bipartiteAdjacency.movieActors.begin() +
+                bipartiteAdjacency.castEnd(movieId));
+        long long key = ((long long)movieTitleIds[movieId] << 32) |
+                        (unsigned int)movieYears[movieId];
+        movieIds.emplace(key, movieId);
+    }
 }
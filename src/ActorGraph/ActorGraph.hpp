@@ -11,58 +11,1219 @@
 #ifndef ACTORGRAPH_HPP
 #define ACTORGRAPH_HPP
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
 #include "ActorNode.hpp"
+#include "BipartiteAdjacency.hpp"
+#include "CSRAdjacency.hpp"
+#include "ContractionHierarchy.hpp"
+#include "DistanceLabels.hpp"
+#include "FrozenArray.hpp"
+#include "MappedFile.hpp"
+#include "PathCache.hpp"
+#include "SearchContext.hpp"
+#include "StringInterner.hpp"
+
+#define MAX_ACTIVE_LANDMARKS 4
 
 using namespace std;
 
-/**
- * The ActorGraph that stores the connections and methods to build the graph and
- * find info about the graph.
- */
-class ActorGraph {
-  protected:
-    // the graph relating the actor's names to their nodes
-    unordered_map<string, ActorNode*> graph;
+/**
+ * The landmarks that bound one weighted search best, with their distances to
+ * the actors at both of its ends
+ */
+struct LandmarkGuide {
+    int numActive;
+    int landmarkIndices[MAX_ACTIVE_LANDMARKS];
+    int startDistances[MAX_ACTIVE_LANDMARKS];
+    int endDistances[MAX_ACTIVE_LANDMARKS];
+};
+
+/**
+ * One row of the movie cast file, for adding to a graph already loaded
+ */
+struct ActorMovieRow {
+    string actor;
+    string movieTitle;
+    int year;
+};
+
+/**
+ * The ActorGraph that stores the connections and methods to build the graph and
+ * find info about the graph.
+ */
+class ActorGraph {
+  protected:
+    // the ids of the actors' names, the index into nodes
+    StringInterner actorNames;
+
+    // every actor node indexed by its id
+    vector<ActorNode*> nodes;
+
+    // the ids of the movie titles, shared by the movies of the same title
+    StringInterner movieTitles;
+
+    // the id of each movie keyed by its title id and year together
+    unordered_map<long long, int> movieIds;
+
+    // the title id and year of each movie indexed by its id
+    FrozenArray<int> movieTitleIds;
+    FrozenArray<int> movieYears;
+
+    // the ids of the actors in each movie, in the order they were read
+    vector<vector<int>> movieCasts;
+
+    // the frozen adjacency the searches run over, built by buildGraph
+    CSRAdjacency adjacency;
+
+    // the actor-movie adjacency, built by buildBipartiteGraph instead
+    BipartiteAdjacency bipartiteAdjacency;
+
+    // true when the graph was built by buildBipartiteGraph
+    bool bipartite;
+
+    // true when buildGraph filled the neighbor maps of each node, otherwise
+    // the neighbors and the spanning tree come from the actor-movie adjacency
+    bool neighborMapsBuilt;
+    bool weightedMapsBuilt;
+
+    // the snapshot the arrays are borrowed from after loadSnapshot
+    MappedFile snapshotFile;
+
+    // how many threads loading, building and searching the graph may use
+    unsigned int numThreads;
+
+    // the paths found so far, filled in by searches on a const graph
+    mutable PathCache pathCache;
+
+    // the actors whose distances guide weighted searches, from buildLandmarks
+    FrozenArray<int> landmarks;
+
+    // the weighted distance from each landmark to every actor, one row per
+    // actor with an entry for each landmark, INT_MAX where it can't reach
+    FrozenArray<int> landmarkDistances;
+
+    // the shortcuts answering weighted searches, built by buildHierarchy
+    ContractionHierarchy hierarchy;
+
+    // the two hop labels answering unweighted searches, from
+    // buildDistanceLabels
+    DistanceLabels labels;
+
+    // the id of each actor's connected component, from buildComponents and
+    // numbered again when asked for once ingest has changed the forest
+    mutable FrozenArray<int> components;
+
+    // the union-find forest of the components, each actor's parent a smaller
+    // actor of its component or itself for the smallest, which ingest joins
+    // the new roles in
+    vector<int> componentParents;
+
+    // whether ingest changed the forest since the components were numbered
+    mutable bool componentsStale;
+
+    // keeps two threads from numbering the components at once
+    mutable mutex componentLock;
+
+    /*
+     * Finds the id of the movie, giving the movie the next id the first time
+     * its title and year are seen together
+     *
+     * Parameters:
+     *              movieTitle - the first character of the movie's title
+     *              length - the number of characters in the title
+     *              titleHash - the hash of the title
+     *              year - the year of the movie
+     *
+     * Return: the id of the movie
+     */
+    int internMovie(const char* movieTitle, size_t length,
+                    unsigned int titleHash, int year);
+
+    /*
+     * Sorts the actors by name and stores each actor's position so ties in
+     * the searches can compare integers instead of strings
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void rankActorNames();
+
+    /*
+     * Splits the actors into one contiguous shard per thread, each with about
+     * the same number of movie roles so the threads finish together
+     *
+     * Parameters: None
+     *
+     * Return: the first actor id of each shard followed by the number of
+     * actors
+     */
+    vector<int> shardActors() const;
+
+    /*
+     * Lays out the edges of every actor into the compressed sparse row
+     * adjacency. Each actor's edges are grouped by movie id and follow the
+     * order of the movie's cast within each movie. The degrees, their prefix
+     * sums and the edges are worked out by shard on every thread. The same
+     * walk can fill the neighbor maps of each node the way buildGraph always
+     * has.
+     *
+     * Parameters:
+     *              linkNodes - fill the neighbors member of each node
+     *              usingMovieTraveler - also fill neighborsWeighted and
+     *                                   movieNeighborsWeighted
+     *
+     * Return: None
+     */
+    void buildAdjacency(bool linkNodes, bool usingMovieTraveler);
+
+    /*
+     * Lays out the actor-movie adjacency from the cast of each movie, giving
+     * every actor its movies in increasing id. Both ways of building the
+     * graph keep it, it is what the snapshot and the spanning tree fall back
+     * on.
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void buildMovieIndex();
+
+    /*
+     * Labels the connected components of the actors. Each thread takes a
+     * range of the movies and joins the cast of each, and every actor then
+     * gets the id of its component, numbered in order of the smallest actor
+     * id in each. The forest is kept for ingest to join the new roles in,
+     * and the snapshot saves the ids.
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void buildComponents();
+
+    /*
+     * Joins the components of two actors in the forest, giving any actor
+     * added since it was last grown a tree of its own first. The ids are
+     * numbered again the next time they are asked for.
+     *
+     * Parameters:
+     *              firstId - the id of one actor
+     *              secondId - the id of the other actor
+     *
+     * Return: None
+     */
+    void joinComponents(int firstId, int secondId);
+
+    /*
+     * Numbers the components again from the forest if ingest has changed it,
+     * in order of the smallest actor id in each
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void numberComponents() const;
+
+    /*
+     * Tells if two actors may be connected, which they can't be when the
+     * forest puts them in different trees
+     *
+     * Parameters:
+     *              firstId - the id of one actor
+     *              secondId - the id of the other actor
+     *
+     * Return: false if the actors are in different components, true
+     * otherwise or if the graph has no component labels
+     */
+    bool sameComponent(int firstId, int secondId) const;
+
+    /*
+     * Relates the actor just added to the end of the movie's cast to the rest
+     * of the cast, the same way building the graph would have
+     *
+     * Parameters:
+     *              actorId - the actor added to the cast
+     *              movieId - the movie the actor was added to
+     *
+     * Return: None
+     */
+    void linkRole(int actorId, int movieId);
+
+    /*
+     * Merges the actors added since the last ranking into the name ranks
+     * without sorting every name again
+     *
+     * Parameters:
+     *              firstNewActor - the id of the first actor added
+     *
+     * Return: None
+     */
+    void rankNewActors(int firstNewActor);
+
+    /*
+     * Gives a graph mapped from a snapshot back the cast of each movie and
+     * the ids of the movies by title and year, which the snapshot leaves out
+     * since only ingest needs them
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void restoreMovieCasts();
+
+    /*
+     * Kruskal over the actor-movie adjacency. Every pair of actors in a movie
+     * has the movie's weight, so any tree linking the cast is as light as any
+     * other. The movies are taken from lightest to heaviest and each one links
+     * its cast to its first actor, skipping actors already in the same
+     * up-tree. The movie of each chosen edge is recorded in
+     * movieNeighborsWeighted for printing.
+     *
+     * Parameters:
+     *              result - a reference to all the possible efficient
+     * connections of the tree
+     *
+     * Return: None
+     */
+    void minimumSpanningBipartite(
+        unordered_map<ActorNode*, vector<pair<ActorNode*, int>>>& result);
+
+    /*
+     * Calls the visit with every neighbor of the actor and the movie relating
+     * them, in the order the adjacency lists them. Over the actor-movie
+     * adjacency a movie's cast is only visited by the first actor of the side
+     * to open it, every later actor would find the whole cast already
+     * reached, so a search finds the same path over either representation.
+     *
+     * Parameters:
+     *              actorId - the actor whose neighbors to visit
+     *              side - the side of the search doing the visiting
+     *              visit - called with the id of each neighbor, the movie id
+     *                      and the movie's weight
+     *
+     * Return: None
+     */
+    template <typename Visit>
+    void visitNeighbors(int actorId, SearchSide& side, Visit visit) const;
+
+    /*
+     * Calls the visit with every neighbor of the actor and the movie relating
+     * them, in the order the adjacency lists them, opening every movie again
+     * for searches that don't settle actors in order of distance
+     *
+     * Parameters:
+     *              actorId - the actor whose neighbors to visit
+     *              visit - called with the id of each neighbor, the movie id
+     *                      and the movie's weight
+     *
+     * Return: None
+     */
+    template <typename Visit>
+    void visitEdges(int actorId, Visit visit) const;
+
+    /*
+     * Calls the match with the neighbors of the actor and the movie relating
+     * them, in the order the adjacency lists them, until it returns true
+     *
+     * Parameters:
+     *              actorId - the actor whose neighbors to match
+     *              match - called with the id of each neighbor and the movie
+     *                      id, true to stop
+     *
+     * Return: true if the match stopped at a neighbor, false otherwise
+     */
+    template <typename Match>
+    bool findNeighbor(int actorId, Match match) const;
+
+    /*
+     * Expands the deepest level of one side of a bidirectional BFS, queueing
+     * the next level behind it in the order a one way BFS would
+     *
+     * Parameters:
+     *              side - the side to expand
+     *              levelBegin - where the deepest level starts in the side's
+     *                           frontier, moved to where the new level starts
+     *              other - the side searching from the other end
+     *
+     * Return: true if the new level reached an actor the other side reached
+     */
+    bool expandLevel(SearchSide& side, int& levelBegin,
+                     const SearchSide& other) const;
+
+    /*
+     * Expands the deepest level of one side of a BFS bottom up: every actor
+     * the side hasn't reached, found a word at a time in a bitmap of the
+     * actors it has, looks through its own neighbors for one in the bitmap
+     * of the level and stops at the first. Once a level covers much of the
+     * graph this checks far fewer edges than expanding the level, but the
+     * next level is queued in order of id rather than in the order a one
+     * way BFS would queue it.
+     *
+     * Parameters:
+     *              side - the side to expand, its frontier holding every
+     *                     actor it reached
+     *              levelBegin - where the deepest level starts in the side's
+     *                           frontier, moved to where the new level starts
+     *              other - the side searching from the other end
+     *
+     * Return: true if the new level reached an actor the other side reached
+     */
+    bool expandLevelBottomUp(SearchSide& side, int& levelBegin,
+                             const SearchSide& other) const;
+
+    /*
+     * Runs a bidirectional BFS from the start and the end, expanding a whole
+     * level of whichever side has the smaller frontier until the sides meet.
+     * The forward side searches in the same order as a one way BFS, so the
+     * prev and connector it leaves behind already match one. Past its deepest
+     * level, only the actors the backward side found on a shortest path are
+     * walked in that same order, so ties break the way a one way BFS breaks
+     * them. Only the backward side's distances are used, so it expands bottom
+     * up whenever its level is large next to the actors it has left. Every
+     * way no longer than the levels of both sides together would already
+     * have met, so the search gives up once they add up to the context's
+     * limit.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool unweightedSearch(int start, int end, SearchContext& context) const;
+
+    /*
+     * Settles the next actor of one side of a bidirectional Dijkstra,
+     * relaxing its edges the way a one way Dijkstra would. Every edge leading
+     * to an actor the other side reached is a way through both sides.
+     *
+     * Parameters:
+     *              side - the side to settle, its queue's top must not be
+     *                     stale
+     *              other - the side searching from the other end
+     *              best - the length of the shortest way through both sides,
+     *                     lowered by any shorter one found
+     *
+     * Return: the id of the actor settled
+     */
+    int settleNext(SearchSide& side, const SearchSide& other, int& best) const;
+
+    /*
+     * Runs a bidirectional Dijkstra from the start and the end, settling an
+     * actor of whichever side has the smaller queue until the tops of both
+     * queues add up to no less than the shortest way through both sides.
+     * Every actor nearer the end than the backward side's top is then settled
+     * from the end, which gives the rest of the way exactly. The forward side
+     * goes on settling in the order a one way Dijkstra would, only relaxing
+     * the actors that can still lie on a shortest path, so ties break the way
+     * a one way Dijkstra breaks them. No way left to find is lighter than the
+     * two tops together, so the search gives up once they pass the context's
+     * limit.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool weightedSearch(int start, int end, SearchContext& context) const;
+
+    /*
+     * Picks the landmarks whose distances to the two ends differ the most,
+     * since those give the tightest bounds around the search
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              guide - set to the landmarks picked
+     *
+     * Return: false if a landmark reaches only one of the two so they aren't
+     * connected, true otherwise
+     */
+    bool guideSearch(int start, int end, LandmarkGuide& guide) const;
+
+    /*
+     * Finds the lower bounds the guide's landmarks give on the weighted
+     * distances from the actor to both ends of the search: by the triangle
+     * inequality each is no less than the difference of their distances
+     * from any landmark. The actor must be connected to the ends.
+     *
+     * Parameters:
+     *              actorId - the actor to bound the distances from
+     *              guide - the landmarks of the search
+     *              toStart - set to the bound on the distance to the start
+     *              toEnd - set to the bound on the distance to the end
+     *
+     * Return: None
+     */
+    void landmarkBounds(int actorId, const LandmarkGuide& guide, int& toStart,
+                        int& toEnd) const;
+
+    /*
+     * Settles the next actor of one side of a bidirectional A*, relaxing its
+     * edges and queueing each neighbor by twice its distance plus the bound
+     * toward the side's goal less the bound back to its source. Every edge
+     * leading to an actor the other side reached is a way through both
+     * sides.
+     *
+     * Parameters:
+     *              side - the side to settle, its queue's top must not be
+     *                     stale
+     *              other - the side searching from the other end
+     *              guide - the landmarks of the search
+     *              fromStart - true for the side searching from the start
+     *              best - the length of the shortest way through both sides,
+     *                     lowered by any shorter one found
+     *
+     * Return: the id of the actor settled
+     */
+    int settleGuided(SearchSide& side, const SearchSide& other,
+                     const LandmarkGuide& guide, bool fromStart,
+                     int& best) const;
+
+    /*
+     * Runs a bidirectional A* from the start and the end, guided by the
+     * landmarks' lower bounds. Each side is ordered by the average of the
+     * bounds toward its goal and away from its source, which keeps the two
+     * sides consistent with each other, so they can stop the way a
+     * bidirectional Dijkstra does and every actor either settles is at its
+     * exact distance. The forward side then goes on settling with the
+     * backward side's exact distances as its bounds, until every actor on a
+     * shortest path is settled, and the path is picked out the way a one way
+     * Dijkstra breaks its ties.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool landmarkSearch(int start, int end, SearchContext& context) const;
+
+    /*
+     * Points prev and connector along a shortest path from the end back to
+     * the start at what a one way Dijkstra would have left there: the
+     * actor before each one is the nearest, then first by name, of those a
+     * shortest path can come through, and the movie is the first of that
+     * actor's lightest movies with it
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              side - the side of a search that settled every actor on a
+     *                     shortest path at its exact distance
+     *
+     * Return: None
+     */
+    void settleTies(int start, int end, SearchSide& side) const;
+
+    /*
+     * Settles every node below the core that one side of a hierarchy search
+     * climbs to, leaving the core nodes it reaches on its frontier for the
+     * search inside the core. A node the other side already climbed to is a
+     * way through both sides.
+     *
+     * Parameters:
+     *              side - the side to climb, its end already reached
+     *              other - the side searching from the other end
+     *              best - the length of the lightest way through both
+     *                     sides, lowered by any lighter one found
+     *              meeting - set to the node of the lightest way both sides
+     *                        reach
+     *
+     * Return: None
+     */
+    void climbHierarchy(SearchSide& side, const SearchSide& other, int& best,
+                        int& meeting) const;
+
+    /*
+     * Runs a bidirectional Dijkstra over the contraction hierarchy from the
+     * start and the end. Each side first climbs the edges up to nodes
+     * contracted later until it reaches the core, then the two sides search
+     * the core from the core nodes they reached the way a bidirectional
+     * Dijkstra would, stopping once their tops add up to no less than the
+     * lightest way through both sides. The way is then unpacked into its
+     * actors and movies and laid out along prev and connector. Of several
+     * ways equally light the one found isn't always the one a one way
+     * Dijkstra would find.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool hierarchySearch(int start, int end, SearchContext& context) const;
+
+    /*
+     * Appends the nodes along the lightest way between two nodes linked in
+     * the hierarchy, replacing each shortcut with the two edges it skips
+     *
+     * Parameters:
+     *              from - the node the way starts at, already on the way
+     *              to - the node the way ends at
+     *              way - the nodes of the way are appended to it
+     *
+     * Return: None
+     */
+    void unpackEdge(int from, int to, vector<int>& way) const;
+
+    /*
+     * Runs the pruned BFS of one hub of the labels. An actor is left out,
+     * along with every actor past it, once the labels already built give a
+     * way between it and the hub that is as short as the one the BFS found.
+     *
+     * Parameters:
+     *              hub - the id of the actor to search from
+     *              built - the label of every actor built so far
+     *              hubLabel - the hops from the hub to each hub of its label,
+     *                         MAX_LABEL_DISTANCE + 1 where it has none
+     *              side - the actors whose labels get the hub are left on
+     *                     its frontier, each at its distance from the hub
+     *
+     * Return: false if an actor was more than MAX_LABEL_DISTANCE hops from
+     * the hub, true otherwise
+     */
+    bool labelHub(int hub, const vector<vector<LabelEntry>>& built,
+                  const vector<unsigned char>& hubLabel,
+                  SearchSide& side) const;
+
+    /*
+     * Finds a shortest path from the labels alone: the hub the two labels
+     * are closest through is found by merging them, and the next actor of
+     * each entry is followed from both ends to the hub, one hop at a time.
+     * The path is laid out along prev and connector. Of several paths
+     * equally short the one found isn't always the one a one way BFS would
+     * find.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              context - holds the distance, prev and connector of every
+     *                        actor on the path
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool labelSearch(int start, int end, SearchContext& context) const;
+
+    /*
+     * Searches for the path of one pair. A weighted search goes up the
+     * contraction hierarchy when the graph has one, or is guided by the
+     * landmarks when it has those, and an unweighted one follows the
+     * distance labels when it has them. Otherwise every search runs from
+     * both ends. A context that doesn't track paths only gets the length of
+     * the way. A way longer than the context's limit isn't found, and actors
+     * in different components aren't searched at all.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              useWeighted - use the movie weights instead of hop counts
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool pairSearch(int start, int end, bool useWeighted,
+                    SearchContext& context) const;
+
+    /*
+     * Finds the length of a shortest way between two actors without the
+     * path. The labels give the hops straight away, and any other search
+     * stops as soon as it knows the length, keeping no prev or connector on
+     * the way.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              useWeighted - use the movie weights instead of hop counts
+     *              context - the search state to use
+     *
+     * Return: the number of movies or the total weight of the movies on the
+     * way, -1 if the two aren't connected
+     */
+    int pairDistance(int start, int end, bool useWeighted,
+                     SearchContext& context) const;
+
+    /*
+     * Runs a one way BFS or Dijkstra from the start until every target is
+     * found, leaving prev and connector on every actor reached the way a
+     * search to each target alone would
+     *
+     * Parameters:
+     *              start - the id of the actor to search from
+     *              targets - the ids of the actors to find, without repeats
+     *                        or the start, none to search every actor the
+     *                        start reaches
+     *              useWeighted - use the movie weights instead of hop counts
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached, the targets reached are final
+     *
+     * Return: None
+     */
+    void searchFrom(int start, const vector<int>& targets, bool useWeighted,
+                    SearchContext& context) const;
+
+    /*
+     * Runs a level synchronous BFS from the start over every actor it
+     * reaches, on all of the graph's threads. Each level is split among the
+     * threads, expanded top down while it is small, each movie opened by
+     * the first thread to reach it and each actor claimed by the first to
+     * reach it, and bottom up once it is large next to the actors left, each
+     * thread looking through its own range of the actors not reached.
+     *
+     * Parameters:
+     *              start - the id of the actor to search from
+     *              distances - set to the hops to every actor, -1 where it
+     *                          doesn't reach
+     *
+     * Return: None
+     */
+    void parallelBFS(int start, vector<atomic<int>>& distances) const;
+
+    /*
+     * Runs a delta stepping search from the start over every actor it
+     * reaches, on all of the graph's threads. The actors wait in buckets
+     * DELTA_STEP_WIDTH wide by distance, and the lightest bucket is emptied
+     * by relaxing the light movies of all of its actors at once, over and
+     * over until none come back to it, then their heavy movies once. A movie
+     * is only gone through again by an actor nearer than the last one.
+     *
+     * Parameters:
+     *              start - the id of the actor to search from
+     *              distances - set to the total weight to every actor, -1
+     *                          where it doesn't reach
+     *
+     * Return: None
+     */
+    void deltaStepping(int start, vector<atomic<int>>& distances) const;
+
+    /*
+     * Picks the actor and movie each actor is reached through on a shortest
+     * path from the source: the first neighbor, in the order of the actor's
+     * movies and their casts, whose distance and the movie add up to the
+     * actor's. The actors are split among the graph's threads.
+     *
+     * Parameters:
+     *              useWeighted - use the movie weights instead of hop counts
+     *              result - holds the distance to every actor, previous and
+     *                       connectors are set
+     *
+     * Return: None
+     */
+    void findPrevious(bool useWeighted, ActorDistances& result) const;
+
+    /*
+     * Runs a bit-parallel BFS from up to MULTI_SOURCE_WIDTH actors at once,
+     * one bit of every actor's words for each of them. Each level is
+     * expanded for every source with one pass over the edges, through the
+     * movies over the actor-movie adjacency, and the bits new to an actor
+     * give its distance from those sources.
+     *
+     * Parameters:
+     *              sources - the ids of the actors to search from
+     *              search - holds the distance from each source to every
+     *                       actor
+     *
+     * Return: false if an actor was more than MULTI_SOURCE_UNREACHED - 1
+     * hops from a source, which leaves the distances unfinished, true
+     * otherwise
+     */
+    bool multiSourceSearch(const vector<int>& sources,
+                           MultiSourceSearch& search) const;
+
+    /*
+     * Walks a one way BFS from the start toward the end, only queueing the
+     * actors one hop closer to the end, in the order a one way BFS would
+     * queue them. Every actor the BFS would reach the end through is kept,
+     * so prev and connector break ties the way a one way BFS breaks them.
+     *
+     * Parameters:
+     *              start - the id of the first actor
+     *              end - the id of the second actor
+     *              toEnd - the hops from every actor to the end,
+     *                      MULTI_SOURCE_UNREACHED where it doesn't reach
+     *              context - holds the distance, prev and connector of every
+     *                        actor reached
+     *
+     * Return: true if the end was reached, false otherwise
+     */
+    bool followDistances(int start, int end, const unsigned char* toEnd,
+                         SearchContext& context) const;
+
+    /*
+     * Finds the paths of the pairs sharing their second actors with
+     * bit-parallel BFS from those actors, MULTI_SOURCE_WIDTH at a time, each
+     * batch handed out as a thread frees up. Every pair then follows the
+     * distances to its second actor from its first. One BFS over the whole
+     * graph costs about as much as a few hundred searches from both ends, so
+     * the second actors are batched from the most shared down, and only
+     * while a batch answers at least MULTI_SOURCE_MIN_PAIRS pairs. A search
+     * that runs too deep falls back to searching each of its pairs on its
+     * own. Each thread keeps a byte for every actor from each source, so no
+     * more threads batch than fit in MULTI_SOURCE_MAX_BYTES, and a graph too
+     * large for even one leaves every pair to the searches from both ends.
+     *
+     * Parameters:
+     *              queries - the first actor and the index of each pair,
+     *                        left with the pairs not answered
+     *              ends - the second actor of every pair by index
+     *              paths - set to the ids along the path of each pair
+     *                      answered by index
+     *
+     * Return: None
+     */
+    void multiSourcePaths(vector<pair<int, int>>& queries,
+                          const vector<int>& ends,
+                          vector<vector<int>>& paths) const;
+
+    /*
+     * Follows prev back from the end of a search to its start, collecting
+     * each actor and connecting movie along the way
+     *
+     * Parameters:
+     *              end - the id of the actor the search stopped at
+     *              context - the state the search left behind
+     *
+     * Return: the ids along the path from the end back to the start,
+     * alternating between actor ids and movie ids
+     */
+    vector<int> tracePath(int end, const SearchContext& context) const;
+
+    /*
+     * Formats each actor and movie of a traced path
+     *
+     * Parameters:
+     *              path - the ids along the path, alternating between actor
+     *                     ids and movie ids
+     *
+     * Return: the names of the actors and the formatted movies in the same
+     * order
+     */
+    vector<string> formatPath(const vector<int>& path) const;
+
+    /*
+     * Looks the pair up in the path cache, searching the graph for it and
+     * caching what was found on a miss. A path past the context's limit isn't
+     * returned, and a search that found nothing within the limit isn't
+     * cached, since the pair may still be connected.
+     *
+     * Parameters:
+     *              firstId - the id of the first actor
+     *              secondId - the id of the second actor, not the first
+     *              useWeighted - use the movie weights instead of hop counts
+     *              context - the search state to use on a miss
+     *
+     * Return: the ids along the path from the second actor back to the
+     * first, empty if the actors aren't connected within the limit
+     */
+    vector<int> findPath(int firstId, int secondId, bool useWeighted,
+                         SearchContext& context) const;
+
+    /*
+     * Adds up the length of a path laid out the way findPath returns it
+     *
+     * Parameters:
+     *              path - the ids along the path, movie ids in between actor
+     *                     ids
+     *              useWeighted - use the movie weights instead of hop counts
+     *
+     * Return: the number of movies or the total weight of the movies on the
+     * path, 0 for an empty one
+     */
+    int pathLength(const vector<int>& path, bool useWeighted) const;
+
+    /*
+     * Identifies the graph the cached paths were found in, so paths saved for
+     * another graph aren't used. The names, the movies and their years and
+     * who was in each movie all go into the hash, so any change to what the
+     * ids of a cached path stand for or to the ways between them gives
+     * another one. The rows are hashed one at a time, so rows grown by ingest
+     * hash the same as once packed, and both representations of a graph hash
+     * the same.
+     *
+     * Parameters: None
+     *
+     * Return: a hash of the contents of the graph
+     */
+    unsigned long long pathCacheFingerprint() const;
+
+    /*
+     * Returns the search context of the calling thread, kept between searches
+     * so they don't allocate
+     *
+     * Parameters: None
+     *
+     * Return: the calling thread's search context
+     */
+    static SearchContext& threadContext();
+
+  public:
+    /**
+     * Constuctor of the Actor graph
+     */
+    ActorGraph(void);
+
+    /*
+     * The destructor for deallocating memory for each actor node
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    ~ActorGraph();
+
+    /*
+     * Sets how many threads loading, building and searching the graph may
+     * use
+     *
+     * Parameters:
+     *              threads - the number of threads, 0 for one per core
+     *
+     * Return: None
+     */
+    void setNumThreads(unsigned int threads);
+
+    /*
+     * Returns how many threads loading, building and searching the graph
+     * may use
+     *
+     * Parameters: None
+     *
+     * Return: the number of threads
+     */
+    unsigned int getNumThreads() const;
+
+    /*
+     * Sets how many bytes the path cache may use
+     *
+     * Parameters:
+     *              bytes - the memory cap, 0 turns the cache off
+     *
+     * Return: None
+     */
+    void setPathCacheCapacity(size_t bytes);
+
+    /*
+     * Returns the cache of the paths found so far, for its counters
+     *
+     * Parameters: None
+     *
+     * Return: the path cache
+     */
+    const PathCache& getPathCache() const;
+
+    /*
+     * Writes the cached paths to a file, usually next to the graph's snapshot
+     *
+     * Parameters:
+     *              filename - the file to write
+     *
+     * Return: true if the file was written, false otherwise
+     */
+    bool savePathCache(const char* filename) const;
 
-    // the hashmap of the movies and the actors having relations with this movie
-    unordered_map<string, unordered_map<int, vector<ActorNode*>>> movies;
+    /*
+     * Reads the paths a run over the same graph saved before
+     *
+     * Parameters:
+     *              filename - the file to read
+     *
+     * Return: true if the file belonged to the graph and was read, false
+     * otherwise
+     */
+    bool loadPathCache(const char* filename);
 
-  public:
-    /**
-     * Constuctor of the Actor graph
+    /*
+     * Picks the landmarks that guide weighted searches farthest first: the
+     * actor in the most movies, then each time the actor farthest from every
+     * landmark picked so far that they reach. A one way Dijkstra from each
+     * one stores its distance to every actor. The landmarks go into the
+     * snapshot, and are dropped when ingest changes the graph.
+     *
+     * Parameters:
+     *              count - the number of landmarks, 0 drops them
+     *
+     * Return: None
      */
-    ActorGraph(void);
+    void buildLandmarks(int count);
 
     /*
-     * The destructor for deallocating memory for each actor node
+     * Returns the number of landmarks guiding weighted searches
+     *
+     * Parameters: None
+     *
+     * Return: the number of landmarks, 0 if none were built
+     */
+    int getNumLandmarks() const;
+
+    /*
+     * Contracts the actors and movies in order of how few shortcuts each
+     * adds for the edges it removes, spread out by how many of its neighbors
+     * are gone already, leaving the nodes with too many neighbors as the
+     * core. The upward edges of each node and the edges inside the core are
+     * kept as the hierarchy, which answers weighted searches from then on.
+     * The snapshot saves it and ingest drops it.
      *
      * Parameters: None
      *
      * Return: None
      */
-    ~ActorGraph();
+    void buildHierarchy();
+
+    /*
+     * Tells if a contraction hierarchy answers the weighted searches
+     *
+     * Parameters: None
+     *
+     * Return: true if buildHierarchy or the snapshot gave the graph one
+     */
+    bool hasHierarchy() const;
+
+    /*
+     * Builds the two hop labels giving the exact number of hops between any
+     * two actors. The actors are taken as hubs in order of how many
+     * neighbors they have, most first, and a BFS from each hub adds it to the
+     * label of every actor the hubs before it don't already give the
+     * distance to. The hubs are searched in batches on every thread, each
+     * batch pruned by the labels of the batches before it, with the batches
+     * growing with the number of labels built. The labels answer unweighted
+     * searches from then on. The snapshot saves them and ingest drops them.
+     * A graph without well connected actors needs labels about as long as
+     * the number of actors, so the build gives up once they pass
+     * MAX_AVERAGE_LABEL_SIZE entries per actor on average.
+     *
+     * Parameters: None
+     *
+     * Return: false if two actors were more than MAX_LABEL_DISTANCE hops
+     * apart or the labels grew too long, which leaves the graph without
+     * labels, true otherwise
+     */
+    bool buildDistanceLabels();
+
+    /*
+     * Tells if distance labels answer the unweighted searches
+     *
+     * Parameters: None
+     *
+     * Return: true if buildDistanceLabels or the snapshot gave the graph
+     * labels
+     */
+    bool hasDistanceLabels() const;
+
+    /*
+     * Finds the component of the actor
+     *
+     * Parameters:
+     *              actorName - the name of the actor
+     *
+     * Return: the id of the actor's component, -1 if the actor doesn't exist
+     * or the graph has no component labels
+     */
+    int componentOf(const string& actorName) const;
+
+    /*
+     * Counts the actors in each component
+     *
+     * Parameters: None
+     *
+     * Return: the number of actors in each component indexed by its id,
+     * empty if the graph has no component labels
+     */
+    vector<int> componentSizes() const;
+
+    /*
+     * Finds the number of hops between two actors, merging their labels
+     * when the graph has them and otherwise searching from both ends
+     *
+     * Parameters:
+     *              firstActor - the name of the first actor
+     *              secondActor - the name of the second actor
+     *
+     * Return: the number of movies on a shortest path between the two, -1
+     * if an actor doesn't exist or they aren't connected
+     */
+    int unweightedDistance(const string& firstActor,
+                           const string& secondActor) const;
+
+    /*
+     * Finds the total weight of the movies on a lightest way between two
+     * actors, the same way shortestWeightedPath searches but without the
+     * path
+     *
+     * Parameters:
+     *              firstActor - the name of the first actor
+     *              secondActor - the name of the second actor
+     *
+     * Return: the total weight of the way, -1 if an actor doesn't exist or
+     * they aren't connected
+     */
+    int weightedDistance(const string& firstActor,
+                         const string& secondActor) const;
+
+    /*
+     * Finds the length of a shortest way between every pair on all of the
+     * graph's threads, without the paths. The pairs are handed out a block
+     * at a time as threads free up, each thread searching with a context of
+     * its own.
+     *
+     * Parameters:
+     *              pairs - the first and second actor of each search
+     *              useWeighted - use the movie weights instead of hop counts
+     *
+     * Return: the number of movies or total weight between each pair in the
+     * order of the pairs, -1 where an actor doesn't exist or the two aren't
+     * connected
+     */
+    vector<int> shortestDistances(const vector<pair<string, string>>& pairs,
+                                  bool useWeighted) const;
+
+    /*
+     * Returns the actor nodes for debugging purposes
+     *
+     * Parameters: None
+     *
+     * Return: every actor node indexed by its id
+     */
+    const vector<ActorNode*>& getGraph() const;
+
+    /*
+     * Looks up the id of the actor
+     *
+     * Parameters:
+     *              actorName - the name of the actor
+     *
+     * Return: the id of the actor, -1 if the actor doesn't exist
+     */
+    int getActorId(const string& actorName) const;
+
+    /*
+     * Returns the name of the actor, used when printing results
+     *
+     * Parameters:
+     *              actorId - the id of the actor
+     *
+     * Return: the name of the actor
+     */
+    string getActorName(int actorId) const;
+
+    /*
+     * Returns the node of the actor
+     *
+     * Parameters:
+     *              actorId - the id of the actor
+     *
+     * Return: the node of the actor
+     */
+    ActorNode* getNode(int actorId) const;
+
+    /*
+     * Returns the number of actors in the graph
+     *
+     * Parameters: None
+     *
+     * Return: the number of actors
+     */
+    int getNumActors() const;
+
+    /*
+     * Returns the number of movies in the graph
+     *
+     * Parameters: None
+     *
+     * Return: the number of movies
+     */
+    int getNumMovies() const;
+
+    /*
+     * Tells which representation the graph was built with
+     *
+     * Parameters: None
+     *
+     * Return: true if built by buildBipartiteGraph, false if by buildGraph
+     */
+    bool isBipartite() const;
+
+    /*
+     * Finds how many movies the actor shares with each of its neighbors. When
+     * buildGraph filled the neighbors member of the node that is returned,
+     * otherwise it is counted through the actor's movies.
+     *
+     * Parameters:
+     *              actor - the node of the actor
+     *
+     * Return: the number of movies shared with each neighbor
+     */
+    unordered_map<ActorNode*, int> getNeighbors(ActorNode* actor) const;
+
+    /*
+     * Formats the movie of the id the same way as formatMovieAndYear, used
+     * when printing results
+     *
+     * Parameters:
+     *              movieId - the id of the movie
+     *
+     * Return: the formal version of the movie and year
+     */
+    string formatMovie(int movieId) const;
+
+    /*
+     * Writes the name of the actor straight from where the names are kept,
+     * without building a string, used when printing many results
+     *
+     * Parameters:
+     *              out - the stream to write to
+     *              actorId - the id of the actor
+     *
+     * Return: None
+     */
+    void writeActorName(ostream& out, int actorId) const;
+
+    /*
+     * Writes the movie of the id the way formatMovie formats it, without
+     * building a string, used when printing many results
+     *
+     * Parameters:
+     *              out - the stream to write to
+     *              movieId - the id of the movie
+     *
+     * Return: None
+     */
+    void writeMovie(ostream& out, int movieId) const;
 
     /*
-     * Returns the graph for debugging purposes
+     * Returns the frozen adjacency built at the end of buildGraph
      *
      * Parameters: None
      *
-     * Return: the hashmap of the graph
+     * Return: the compressed sparse row adjacency of the graph
      */
-    unordered_map<string, ActorNode*> getGraph();
+    const CSRAdjacency& getAdjacency() const;
 
     /*
      * Using the given formula for edge weight, the method finds the weight of
-     * each edge.
+     * each edge. A movie from after CURRENT_YEAR weighs 1 like one from that
+     * year, so no edge is free or negative and the weighted searches stay in
+     * order.
      *
      * Parameters:
      *              movieYear - the year of the current movie
      *
-     * Return: the weight as an int
+     * Return: the weight as an int, at least 1
      */
-    int edgeWeight(int movieYear);
+    int edgeWeight(int movieYear) const;
 
     /*
      * For the proper format of movies and year, the method formally returns the
@@ -74,7 +1235,7 @@ class ActorGraph {
      *
      * Return: the formal version of the movie and year
      */
-    string formatMovieAndYear(string movie, int year);
+    string formatMovieAndYear(const string& movie, int year) const;
 
     /*
      * Looks in graph to find if the actor exists
@@ -84,13 +1245,15 @@ class ActorGraph {
      *
      * Return: true - exists actor, false - doesn't exist actor
      */
-    bool checkIfActorExists(string actorName);
+    bool checkIfActorExists(const string& actorName) const;
 
     /*
-     * With the given movies hash map, we iterate over each element across each
-     * movie, knowing that all the nodes in the movie are related to each other
-     * by this movie. Using left and right pointers to assign relations to each
-     * node's edge member variable.
+     * With the cast of each movie, every actor is related to every other
+     * actor in the movie. The actors are split into contiguous shards, one per
+     * thread, and each thread walks the movies of its own actors to assign
+     * relations to each node's neighbors and lay out its edges, so no two
+     * threads touch the same node. Finishes with the compressed sparse row
+     * adjacency used by the searches, the same as building it on one thread.
      *
      * Parameters:
      *              usingMovieTraveler - to check for using movie traveler
@@ -100,6 +1263,18 @@ class ActorGraph {
      */
     void buildGraph(bool usingMovieTraveler);
 
+    /*
+     * Builds the actor-movie adjacency instead of linking every pair of actors
+     * in each movie. Each row read becomes one entry on each side, so the
+     * build is linear in the number of rows. The searches, the spanning tree
+     * and the neighbors of each actor all run on it directly.
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void buildBipartiteGraph();
+
     /*
      * Using BFS and Dijkstra, the method searches the graph, having all nodes
      * initially having the distance of INT_MAX to account for each node already
@@ -113,8 +1288,95 @@ class ActorGraph {
      * Return: the path from the first actor to the second actor as a vector,
      * alternating between movie and actors to represent the path.
      */
-    vector<string> shortestUnweightedPath(string firstActor,
-                                          string secondActor);
+    vector<string> shortestUnweightedPath(const string& firstActor,
+                                          const string& secondActor) const;
+
+    /*
+     * Using BFS and Dijkstra, the method searches the graph, having all nodes
+     * initially having the distance of INT_MAX to account for each node already
+     * touched, then finding the distance from the first actor to the second
+     * actor and returning this path. The search state lives in the given
+     * context, so threads can search at once with a context each.
+     *
+     * Parameters:
+     *              firstActor - the string of the first actor
+     *              secondActor - the string of the second actor
+     *              context - the search state to use
+     *
+     * Return: the path from the first actor to the second actor as a vector,
+     * alternating between movie and actors to represent the path.
+     */
+    vector<string> shortestUnweightedPath(const string& firstActor,
+                                          const string& secondActor,
+                                          SearchContext& context) const;
+
+    /*
+     * Finds a shortest path between the two actors the way
+     * shortestUnweightedPath does, but only if it takes no more than the
+     * given number of movies. The search gives up as soon as every way that
+     * short was searched, so two actors far apart cost no more than two near
+     * ones.
+     *
+     * Parameters:
+     *              firstActor - the string of the first actor
+     *              secondActor - the string of the second actor
+     *              maxHops - the most movies the path may take
+     *
+     * Return: the path from the first actor to the second actor as a vector,
+     * alternating between movie and actors to represent the path, empty if
+     * there is none within maxHops.
+     */
+    vector<string> shortestUnweightedPath(const string& firstActor,
+                                          const string& secondActor,
+                                          int maxHops) const;
+
+    /*
+     * Finds the actors within the bound of the center with a one way BFS or
+     * Dijkstra that stops as soon as the next actor would be past it, so only
+     * the neighborhood itself is searched
+     *
+     * Parameters:
+     *              actorName - the name of the actor at the center
+     *              bound - the most movies or total weight from the center
+     *              useWeighted - use the movie weights instead of hop counts
+     *
+     * Return: every actor within the bound in order of distance, the center
+     * first, each with the actor and movie before it on a shortest path,
+     * empty if the actor doesn't exist or the bound is negative
+     */
+    vector<NeighborhoodEntry> neighborhood(const string& actorName, int bound,
+                                           bool useWeighted) const;
+
+    /*
+     * Finds the number of hops from the actor to every actor with a level
+     * synchronous BFS on all of the graph's threads
+     *
+     * Parameters:
+     *              actorName - the name of the actor to search from
+     *
+     * Return: the hops to each actor indexed by id, -1 for the actors it
+     * doesn't reach, empty if the actor doesn't exist
+     */
+    vector<int> unweightedDistances(const string& actorName) const;
+
+    /*
+     * Finds the distance from the actor to every actor in one traversal on
+     * all of the graph's threads, with a level synchronous BFS for hop
+     * counts or delta stepping for the movie weights. The distances are
+     * exact, but of several shortest paths the actor and movie before each
+     * actor may lie on another than a one way search would find.
+     *
+     * Parameters:
+     *              actorName - the name of the actor to search from
+     *              useWeighted - use the movie weights instead of hop counts
+     *              withPrevious - also find the actor and movie before each
+     *              result - set to the distances, and the actors and movies
+     *                       before each if asked for
+     *
+     * Return: false if the actor doesn't exist, true otherwise
+     */
+    bool allDistances(const string& actorName, bool useWeighted,
+                      bool withPrevious, ActorDistances& result) const;
 
     /*
      * Using BFS and Dijkstra, the method searches the graph, having all nodes
@@ -129,7 +1391,83 @@ class ActorGraph {
      * Return: the path from the first actor to the second actor as a vector,
      * alternating between movie and actors to represent the path.
      */
-    vector<string> shortestWeightedPath(string firstActor, string secondActor);
+    vector<string> shortestWeightedPath(const string& firstActor,
+                                        const string& secondActor) const;
+
+    /*
+     * Using BFS and Dijkstra, the method searches the graph, having all nodes
+     * initially having the distance of INT_MAX and accounting for nodes that
+     * have had their neighbors added to queue, the method uses the movie
+     * weights to find the shortest distance. The search state lives in the
+     * given context, so threads can search at once with a context each.
+     *
+     * Parameters:
+     *              firstActor - the string of the first actor
+     *              secondActor - the string of the second actor
+     *              context - the search state to use
+     *
+     * Return: the path from the first actor to the second actor as a vector,
+     * alternating between movie and actors to represent the path.
+     */
+    vector<string> shortestWeightedPath(const string& firstActor,
+                                        const string& secondActor,
+                                        SearchContext& context) const;
+
+    /*
+     * Finds a lightest path between the two actors the way
+     * shortestWeightedPath does, but only if its movies weigh no more than
+     * the given total. The search gives up as soon as every way that light
+     * was searched.
+     *
+     * Parameters:
+     *              firstActor - the string of the first actor
+     *              secondActor - the string of the second actor
+     *              maxWeight - the most the movies of the path may weigh
+     *
+     * Return: the path from the first actor to the second actor as a vector,
+     * alternating between movie and actors to represent the path, empty if
+     * there is none within maxWeight.
+     */
+    vector<string> shortestWeightedPath(const string& firstActor,
+                                        const string& secondActor,
+                                        int maxWeight) const;
+
+    /*
+     * Finds the shortest path of every pair on all of the graph's threads. The
+     * pairs are grouped by their first actor, and each group is searched
+     * once, from both ends if it only has one second actor, or else from the
+     * first actor until every second actor is found. The groups are handed
+     * out as threads free up, so a few long searches don't hold up the rest,
+     * and each thread searches with a context of its own. A weighted batch
+     * over a contraction hierarchy goes up it for each pair instead, and an
+     * unweighted batch over distance labels follows them for each pair. An
+     * unweighted batch without labels first runs bit-parallel BFS from the
+     * second actors many of its pairs share.
+     *
+     * Parameters:
+     *              pairs - the first and second actor of each search
+     *              useWeighted - use the movie weights instead of hop counts
+     *
+     * Return: the ids along the path of each pair in the order of the pairs,
+     * alternating between actor ids and movie ids from the second actor back
+     * to the first, empty where there is none
+     */
+    vector<vector<int>> shortestPathIds(
+        const vector<pair<string, string>>& pairs, bool useWeighted) const;
+
+    /*
+     * Finds the shortest path of every pair the way shortestPathIds does,
+     * then formats each actor and movie along them
+     *
+     * Parameters:
+     *              pairs - the first and second actor of each search
+     *              useWeighted - use the movie weights instead of hop counts
+     *
+     * Return: the path of each pair in the order of the pairs, each laid out
+     * the way shortestUnweightedPath and shortestWeightedPath return them
+     */
+    vector<vector<string>> shortestPaths(
+        const vector<pair<string, string>>& pairs, bool useWeighted) const;
 
     /*
      * Using Kruskal to find all the possible weights of each edge then sorting
@@ -150,7 +1488,9 @@ class ActorGraph {
     /** You can modify this method definition as you wish
      *
      * Load the graph from a tab-delimited file of actor->movie
-     * relationships.
+     * relationships, interning both so the rest of the graph only sees ids.
+     * The file is parsed in one chunk per thread and the rows are interned
+     * in file order, so the ids don't depend on the number of threads.
      *
      * in_filename - input filename
      * use_weighted_edges - if true, compute edge weights as 1 + (2019 -
@@ -159,6 +1499,49 @@ class ActorGraph {
      * return true if file was loaded sucessfully, false otherwise
      */
     bool loadFromFile(const char* in_filename, bool use_weighted_edges);
+
+    /*
+     * Adds rows of the same three columns as the movie cast file to the
+     * graph. Before the graph is built they only join the casts like the rows
+     * of the file. Once it is built, only the rows' movies and actors are
+     * updated: the new edges go after each actor's existing ones, the
+     * neighbor counts and lightest movies are updated in place and new actors
+     * are merged into the name ranks. Each new role joins the component of
+     * its movie's cast, so the cost grows with the rows rather than the
+     * graph.
+     *
+     * Parameters:
+     *              rows - the actor, movie title and year of each new row
+     *
+     * Return: None
+     */
+    void ingest(const vector<ActorMovieRow>& rows);
+
+    /*
+     * Writes the built graph to a binary snapshot: the interned names, the
+     * movies, the rank of each name, both adjacencies, the landmarks, the
+     * hierarchy, the distance labels and the components, each array aligned
+     * so it can be used in place once mapped back in. Rows grown by ingest
+     * are packed first.
+     *
+     * Parameters:
+     *              filename - the snapshot file to write
+     *
+     * Return: true if the snapshot was written, false otherwise
+     */
+    bool saveSnapshot(const char* filename);
+
+    /*
+     * Maps a snapshot written by saveSnapshot and points the graph's arrays
+     * into it instead of reading and building the graph again. Only the
+     * nodes are allocated, so the graph is ready to search right away.
+     *
+     * Parameters:
+     *              filename - the snapshot file to map
+     *
+     * Return: true if the snapshot was valid and loaded, false otherwise
+     */
+    bool loadSnapshot(const char* filename);
 };
 
 #endif  // ACTORGRAPH_HPP
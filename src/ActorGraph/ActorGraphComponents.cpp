@@ -0,0 +1,262 @@
+/*
+ * ActorGraphComponents.cpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ *
+ * Labels the connected components of an ActorGraph with a union-find over
+ * the cast of every movie, so a search between two actors no movies link is
+ * turned down before it starts instead of after it has gone through every
+ * actor the first one reaches. The movies are split among the threads, which
+ * link their casts in the same forest with compare and swap. The graph keeps
+ * the forest, so ingest only joins the casts of the new roles.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ActorGraph.hpp"
+
+#define COMPONENT_MIN_MOVIES 4096
+
+using namespace std;
+
+/*
+ * Finds the root of the node's tree, pointing each node on the way at its
+ * grandparent so later finds take fewer steps. A parent is never a larger id
+ * than its child, so the root is the smallest id of the tree.
+ *
+ * Parameters:
+ *              parents - the parent of every node, itself for a root
+ *              node - the node whose root to find
+ *
+ * Return: the id of the root
+ */
+static int findRoot(vector<atomic<int>>& parents, int node) {
+    while (true) {
+        int parent = parents[node].load(memory_order_relaxed);
+        if (parent == node) {
+            return node;
+        }
+        int grandparent = parents[parent].load(memory_order_relaxed);
+        if (grandparent != parent) {
+            parents[node].compare_exchange_weak(parent, grandparent,
+                                                memory_order_relaxed);
+        }
+        node = grandparent;
+    }
+}
+
+/*
+ * Finds the root of the node's tree without changing the forest, so searches
+ * on many threads can ask at once
+ *
+ * Parameters:
+ *              parents - the parent of every node, itself for a root
+ *              node - the node whose root to find
+ *
+ * Return: the id of the root
+ */
+static int findRoot(const vector<int>& parents, int node) {
+    while (parents[node] != node) {
+        node = parents[node];
+    }
+    return node;
+}
+
+/*
+ * Joins the trees of two nodes by hanging the larger root under the smaller,
+ * trying again if another thread hung the larger root elsewhere first
+ *
+ * Parameters:
+ *              parents - the parent of every node, itself for a root
+ *              first - a node of one tree
+ *              second - a node of the other tree
+ *
+ * Return: None
+ */
+static void unite(vector<atomic<int>>& parents, int first, int second) {
+    while (true) {
+        first = findRoot(parents, first);
+        second = findRoot(parents, second);
+        if (first == second) {
+            return;
+        }
+        if (first < second) {
+            swap(first, second);
+        }
+        int root = first;
+        if (parents[first].compare_exchange_strong(root, second,
+                                                   memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+/*
+ * Labels the connected components of the actors. Each thread takes a range
+ * of the movies and joins the cast of each, and every actor then gets the
+ * id of its component, numbered in order of the smallest actor id in each.
+ * The graph keeps them from every build and ingest, and the snapshot saves
+ * them.
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void ActorGraph::buildComponents() {
+    int numActors = nodes.size();
+    int numMovies = getNumMovies();
+    vector<atomic<int>> parents(numActors);
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        parents[actorId].store(actorId, memory_order_relaxed);
+    }
+
+    // a thread costs about as much to start as a few thousand movies
+    int numWorkers =
+        max(1, min((int)numThreads, numMovies / COMPONENT_MIN_MOVIES));
+    auto work = [&](int worker) {
+        int first = (long long)numMovies * worker / numWorkers;
+        int last = (long long)numMovies * (worker + 1) / numWorkers;
+        for (int movieId = first; movieId < last; movieId++) {
+            int begin = bipartiteAdjacency.castBegin(movieId);
+            for (int i = begin + 1; i < bipartiteAdjacency.castEnd(movieId);
+                 i++) {
+                unite(parents, bipartiteAdjacency.movieActors[begin],
+                      bipartiteAdjacency.movieActors[i]);
+            }
+        }
+    };
+    vector<thread> workers;
+    for (int worker = 1; worker < numWorkers; worker++) {
+        workers.emplace_back(work, worker);
+    }
+    work(0);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    // every actor is hung right under its root, which is the smallest id of
+    // its component, so the root gets a number before any other actor of
+    // the component looks it up
+    componentParents.resize(numActors);
+    vector<int> ids(numActors);
+    int numComponents = 0;
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        int root = findRoot(parents, actorId);
+        componentParents[actorId] = root;
+        ids[actorId] = root == actorId ? numComponents++ : ids[root];
+    }
+    components.assign(move(ids));
+    componentsStale = false;
+}
+
+/*
+ * Joins the components of two actors in the forest, giving any actor added
+ * since it was last grown a tree of its own first. The ids are numbered again
+ * the next time they are asked for.
+ *
+ * Parameters:
+ *              firstId - the id of one actor
+ *              secondId - the id of the other actor
+ *
+ * Return: None
+ */
+void ActorGraph::joinComponents(int firstId, int secondId) {
+    while (componentParents.size() < nodes.size()) {
+        componentParents.push_back(componentParents.size());
+    }
+    componentsStale = true;
+
+    // pointing each actor on the way at its grandparent keeps the trees flat
+    // as they grow
+    for (int* node : {&firstId, &secondId}) {
+        while (componentParents[*node] != *node) {
+            int parent = componentParents[*node];
+            componentParents[*node] = componentParents[parent];
+            *node = parent;
+        }
+    }
+    if (firstId != secondId) {
+        componentParents[max(firstId, secondId)] = min(firstId, secondId);
+    }
+}
+
+/*
+ * Numbers the components again from the forest if ingest has changed it, in
+ * order of the smallest actor id in each
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void ActorGraph::numberComponents() const {
+    lock_guard<mutex> guard(componentLock);
+    if (!componentsStale) {
+        return;
+    }
+    vector<int> ids(componentParents.size());
+    int numComponents = 0;
+    for (unsigned int actorId = 0; actorId < ids.size(); actorId++) {
+        int root = findRoot(componentParents, actorId);
+        ids[actorId] = root == (int)actorId ? numComponents++ : ids[root];
+    }
+    components.assign(move(ids));
+    componentsStale = false;
+}
+
+/*
+ * Tells if two actors may be connected, which they can't be when the forest
+ * puts them in different trees
+ *
+ * Parameters:
+ *              firstId - the id of one actor
+ *              secondId - the id of the other actor
+ *
+ * Return: false if the actors are in different components, true otherwise
+ * or if the graph has no component labels
+ */
+bool ActorGraph::sameComponent(int firstId, int secondId) const {
+    return componentParents.empty() ||
+           findRoot(componentParents, firstId) ==
+               findRoot(componentParents, secondId);
+}
+
+/*
+ * Finds the component of the actor
+ *
+ * Parameters:
+ *              actorName - the name of the actor
+ *
+ * Return: the id of the actor's component, -1 if the actor doesn't exist or
+ * the graph has no component labels
+ */
+int ActorGraph::componentOf(const string& actorName) const {
+    numberComponents();
+    int actorId = actorNames.find(actorName);
+    if (actorId == -1 || components.empty()) {
+        return -1;
+    }
+    return components[actorId];
+}
+
+/*
+ * Counts the actors in each component
+ *
+ * Parameters: None
+ *
+ * Return: the number of actors in each component indexed by its id, empty if
+ * the graph has no component labels
+ */
+vector<int> ActorGraph::componentSizes() const {
+    numberComponents();
+    vector<int> sizes;
+    for (unsigned int actorId = 0; actorId < components.size(); actorId++) {
+        if (components[actorId] == (int)sizes.size()) {
+            sizes.push_back(0);
+        }
+        sizes[components[actorId]]++;
+    }
+    return sizes;
+}
@@ -0,0 +1,293 @@
+/*
+ * ActorGraphHierarchy.cpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ *
+ * Builds the contraction hierarchy of an ActorGraph over its actors and
+ * movies. The node adding the fewest shortcuts for the edges it removes is
+ * contracted next, and a shortcut is only added between two of its neighbors
+ * when a short search around it finds no other way between them that is as
+ * light. Nodes left with too many neighbors stay uncontracted at the top as
+ * the core, where a search follows every edge instead of only the upward
+ * ones.
+ */
+
+#include <climits>
+#include <queue>
+#include <vector>
+#include "ActorGraph.hpp"
+
+#define WITNESS_SETTLE_LIMIT 16
+#define CORE_DEGREE_LIMIT 16
+
+using namespace std;
+
+// an edge of the graph left to contract, a role or a shortcut
+struct HierarchyEdge {
+    int target;  // the node on the other end
+    int weight;  // the weight of the path the edge stands for
+    int middle;  // the node a shortcut skips, -1 for a role
+};
+
+// a shortcut to add once every pair around a node is checked
+struct Shortcut {
+    int first;
+    int second;
+    int weight;
+};
+
+/*
+ * Links two nodes with a shortcut on both of their lists, or lightens the
+ * edge already linking them if the shortcut is lighter
+ *
+ * Parameters:
+ *              edges - the edges of every node
+ *              shortcut - the two nodes and the weight of the way between
+ *              middle - the node the shortcut skips
+ *
+ * Return: None
+ */
+static void linkNodes(vector<vector<HierarchyEdge>>& edges,
+                      const Shortcut& shortcut, int middle) {
+    for (HierarchyEdge& existing : edges[shortcut.first]) {
+        if (existing.target != shortcut.second) {
+            continue;
+        }
+        if (shortcut.weight < existing.weight) {
+            existing = {shortcut.second, shortcut.weight, middle};
+            for (HierarchyEdge& reverse : edges[shortcut.second]) {
+                if (reverse.target == shortcut.first) {
+                    reverse = {shortcut.first, shortcut.weight, middle};
+                }
+            }
+        }
+        return;
+    }
+    edges[shortcut.first].push_back(
+        {shortcut.second, shortcut.weight, middle});
+    edges[shortcut.second].push_back(
+        {shortcut.first, shortcut.weight, middle});
+}
+
+/*
+ * Runs a Dijkstra from the node through the nodes not contracted yet,
+ * leaving out the node being contracted, until it passes the longest way
+ * through that node or settles its limit of nodes. Any distance it leaves
+ * behind is the weight of a way that doesn't need a shortcut.
+ *
+ * Parameters:
+ *              edges - the edges of every node
+ *              contracted - which nodes were contracted
+ *              source - the node to search from
+ *              skipped - the node being contracted
+ *              maxDist - the longest way through the skipped node
+ *              side - holds the distance to every node reached
+ *
+ * Return: None
+ */
+static void searchWitnesses(const vector<vector<HierarchyEdge>>& edges,
+                            const vector<bool>& contracted, int source,
+                            int skipped, int maxDist, SearchSide& side) {
+    side.begin(edges.size(), 0);
+    side.reach(source, 0, -1, -1);
+    side.queue.push({0, 0, source});
+    int settled = 0;
+    while (!side.queue.empty() && settled < WITNESS_SETTLE_LIMIT) {
+        SearchEntry entry = side.queue.pop();
+        if (entry.dist > maxDist) {
+            break;
+        }
+        int curr = entry.actorId;
+        if (side.done(curr)) {
+            continue;
+        }
+        side.finish(curr);
+        settled++;
+        for (const HierarchyEdge& edge : edges[curr]) {
+            int distance = entry.dist + edge.weight;
+            if (contracted[edge.target] || edge.target == skipped ||
+                distance > maxDist || distance >= side.dist(edge.target)) {
+                continue;
+            }
+            side.reach(edge.target, distance, curr, -1);
+            side.queue.push({distance, 0, edge.target});
+        }
+    }
+}
+
+/*
+ * Finds the shortcuts contracting the node takes, one for every pair of its
+ * neighbors whose lightest way between them runs through it
+ *
+ * Parameters:
+ *              edges - the edges of every node
+ *              contracted - which nodes were contracted
+ *              node - the node to contract
+ *              side - the search state of the witness searches
+ *              shortcuts - set to the shortcuts needed
+ *
+ * Return: None
+ */
+static void findShortcuts(const vector<vector<HierarchyEdge>>& edges,
+                          const vector<bool>& contracted, int node,
+                          SearchSide& side, vector<Shortcut>& shortcuts) {
+    vector<HierarchyEdge> around;
+    int maxWeight = 0;
+    for (const HierarchyEdge& edge : edges[node]) {
+        if (!contracted[edge.target]) {
+            around.push_back(edge);
+            maxWeight = max(maxWeight, edge.weight);
+        }
+    }
+
+    shortcuts.clear();
+    for (unsigned int i = 0; i + 1 < around.size(); i++) {
+        searchWitnesses(edges, contracted, around[i].target, node,
+                        around[i].weight + maxWeight, side);
+        for (unsigned int j = i + 1; j < around.size(); j++) {
+            int through = around[i].weight + around[j].weight;
+            if (side.dist(around[j].target) > through) {
+                shortcuts.push_back(
+                    {around[i].target, around[j].target, through});
+            }
+        }
+    }
+}
+
+/*
+ * Contracts the actors and movies in order of how few shortcuts each adds
+ * for the edges it removes, spread out by how many of its neighbors are gone
+ * already. A priority is only worked out again once the node reaches the
+ * top, and the node goes back in if it no longer belongs there. A node
+ * reaching the top with more neighbors left than CORE_DEGREE_LIMIT joins the
+ * core instead, since its shortcuts would grow with the square of them. The
+ * upward edges of each node and every edge between two core nodes are kept
+ * as the hierarchy, which the snapshot saves and ingest drops.
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void ActorGraph::buildHierarchy() {
+    int numActors = nodes.size();
+    int numNodes = numActors + getNumMovies();
+
+    // links each actor to the node of each of its movies
+    vector<vector<HierarchyEdge>> edges(numNodes);
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        for (int i = bipartiteAdjacency.moviesBegin(actorId);
+             i < bipartiteAdjacency.moviesEnd(actorId); i++) {
+            int movieId = bipartiteAdjacency.actorMovies[i];
+            int weight = bipartiteAdjacency.movieWeights[movieId];
+            edges[actorId].push_back({numActors + movieId, weight, -1});
+            edges[numActors + movieId].push_back({actorId, weight, -1});
+        }
+    }
+
+    vector<bool> contracted(numNodes, false);
+    vector<int> removed(numNodes, 0);  // the neighbors contracted so far
+    vector<int> ranks(numNodes);
+    vector<int> core;
+    vector<Shortcut> shortcuts;
+    SearchSide side;
+    auto priority = [&](int node) {
+        int degree = 0;
+        for (const HierarchyEdge& edge : edges[node]) {
+            degree += !contracted[edge.target];
+        }
+        if (degree > CORE_DEGREE_LIMIT) {
+            return INT_MAX;
+        }
+        findShortcuts(edges, contracted, node, side, shortcuts);
+        return (int)shortcuts.size() - degree + removed[node];
+    };
+
+    priority_queue<pair<int, int>, vector<pair<int, int>>,
+                   greater<pair<int, int>>>
+        order;
+    for (int node = 0; node < numNodes; node++) {
+        order.push({priority(node), node});
+    }
+    int nextRank = 0;
+    while (!order.empty()) {
+        int node = order.top().second;
+        order.pop();
+        int current = priority(node);
+        if (current == INT_MAX) {
+            core.push_back(node);
+            continue;
+        }
+        if (!order.empty() && current > order.top().first) {
+            order.push({current, node});
+            continue;
+        }
+
+        // the shortcuts found working out the priority are the ones to add
+        for (const Shortcut& shortcut : shortcuts) {
+            linkNodes(edges, shortcut, node);
+        }
+        contracted[node] = true;
+        ranks[node] = nextRank++;
+        for (const HierarchyEdge& edge : edges[node]) {
+            if (!contracted[edge.target]) {
+                removed[edge.target]++;
+            }
+        }
+    }
+    for (int node : core) {
+        ranks[node] = numNodes;
+    }
+
+    // keeps the edges of each node up to the nodes contracted after it, and
+    // the edges of a core node to every other one
+    vector<int> offsets(numNodes + 1, 0);
+    vector<int> targets;
+    vector<int> weights;
+    vector<int> middles;
+    for (int node = 0; node < numNodes; node++) {
+        for (const HierarchyEdge& edge : edges[node]) {
+            if (ranks[edge.target] > ranks[node] ||
+                ranks[edge.target] == numNodes) {
+                targets.push_back(edge.target);
+                weights.push_back(edge.weight);
+                middles.push_back(edge.middle);
+            }
+        }
+        offsets[node + 1] = targets.size();
+    }
+    hierarchy.ranks.assign(move(ranks));
+    hierarchy.offsets.assign(move(offsets));
+    hierarchy.targets.assign(move(targets));
+    hierarchy.weights.assign(move(weights));
+    hierarchy.middles.assign(move(middles));
+}
+
+/*
+ * Tells if a contraction hierarchy answers the weighted searches
+ *
+ * Parameters: None
+ *
+ * Return: true if buildHierarchy or the snapshot gave the graph one
+ */
+bool ActorGraph::hasHierarchy() const { return !hierarchy.empty(); }
+
+/*
+ * Appends the nodes along the lightest way between two nodes linked in the
+ * hierarchy, replacing each shortcut with the two edges it skips
+ *
+ * Parameters:
+ *              from - the node the way starts at, already on the way
+ *              to - the node the way ends at
+ *              way - the nodes of the way are appended to it
+ *
+ * Return: None
+ */
+void ActorGraph::unpackEdge(int from, int to, vector<int>& way) const {
+    int middle = hierarchy.middles[hierarchy.findEdge(from, to)];
+    if (middle == -1) {
+        way.push_back(to);
+        return;
+    }
+    unpackEdge(from, middle, way);
+    unpackEdge(middle, to, way);
+}
@@ -0,0 +1,261 @@
+/*
+ * ActorGraphLabels.cpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ *
+ * Builds the two hop distance labels of an ActorGraph with a pruned BFS from
+ * every actor, taken as a hub in order of how many neighbors it has. A well
+ * connected actor lies on so many shortest paths that the hubs after the
+ * first few only need to reach a handful of actors, so the labels stay
+ * short and merging two of them gives the number of hops between any pair.
+ * Each entry keeps the actor the hub's BFS reached its actor from, which
+ * leads back to the hub along a shortest path.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+#include <vector>
+#include "ActorGraph.hpp"
+
+#define LABEL_BATCH_DIVISOR 8
+#define LABEL_HUBS_PER_THREAD 16
+#define MAX_AVERAGE_LABEL_SIZE 512
+
+using namespace std;
+
+/*
+ * Builds the two hop labels giving the exact number of hops between any two
+ * actors. The actors are taken as hubs in order of how many neighbors they
+ * have, most first, and a BFS from each hub adds it to the label of every
+ * actor the hubs before it don't already give the distance to. The hubs are
+ * searched in batches on every thread, each batch pruned by the labels of
+ * the batches before it, with the batches growing with the number of labels
+ * built. The labels answer unweighted searches from then on. The snapshot
+ * saves them and ingest drops them. A graph without well connected actors
+ * needs labels about as long as the number of actors, so the build gives up
+ * once they pass MAX_AVERAGE_LABEL_SIZE entries per actor on average.
+ *
+ * Parameters: None
+ *
+ * Return: false if two actors were more than MAX_LABEL_DISTANCE hops apart
+ * or the labels grew too long, which leaves the graph without labels, true
+ * otherwise
+ */
+bool ActorGraph::buildDistanceLabels() {
+    labels.clear();
+    int numActors = nodes.size();
+
+    // the actors with the most neighbors lie on the most shortest paths
+    vector<long long> degrees(numActors, 0);
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        for (int i = bipartiteAdjacency.moviesBegin(actorId);
+             i < bipartiteAdjacency.moviesEnd(actorId); i++) {
+            int movieId = bipartiteAdjacency.actorMovies[i];
+            degrees[actorId] += bipartiteAdjacency.castEnd(movieId) -
+                                bipartiteAdjacency.castBegin(movieId) - 1;
+        }
+    }
+    vector<int> order(numActors);
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        order[actorId] = actorId;
+    }
+    stable_sort(order.begin(), order.end(), [&](int first, int second) {
+        return degrees[first] > degrees[second];
+    });
+
+    // the hubs of a batch only prune with the labels of earlier batches, so
+    // a batch is kept small next to the hubs already done and to the hubs
+    // the threads can search at once
+    vector<vector<LabelEntry>> built(numActors);
+    vector<vector<int>> reached;  // the actors each hub of the batch labels
+    vector<vector<LabelEntry>> entries;  // what each of them gets
+    atomic<bool> tooFar(false);
+    long long numEntries = 0;
+    long long maxEntries = (long long)numActors * MAX_AVERAGE_LABEL_SIZE;
+    for (int first = 0; first < numActors && !tooFar;) {
+        int batchSize =
+            max(1, min(first / LABEL_BATCH_DIVISOR,
+                       (int)numThreads * LABEL_HUBS_PER_THREAD));
+        int last = min(numActors, first + batchSize);
+        reached.assign(last - first, vector<int>());
+        entries.assign(last - first, vector<LabelEntry>());
+
+        // each thread takes the next hub of the batch as it frees up
+        atomic<int> nextHub(first);
+        auto work = [&]() {
+            SearchSide side;
+            vector<unsigned char> hubLabel(numActors, MAX_LABEL_DISTANCE + 1);
+            for (int rank = nextHub++; rank < last && !tooFar;
+                 rank = nextHub++) {
+                int hub = order[rank];
+                for (const LabelEntry& entry : built[hub]) {
+                    hubLabel[entry.hub] = entry.distance;
+                }
+                hubLabel[rank] = 0;
+                if (!labelHub(hub, built, hubLabel, side)) {
+                    tooFar = true;
+                }
+                for (const LabelEntry& entry : built[hub]) {
+                    hubLabel[entry.hub] = MAX_LABEL_DISTANCE + 1;
+                }
+                hubLabel[rank] = MAX_LABEL_DISTANCE + 1;
+
+                reached[rank - first] = side.frontier;
+                for (int actorId : side.frontier) {
+                    LabelEntry entry = {rank,
+                                        (unsigned char)side.dist(actorId),
+                                        side.prev(actorId)};
+                    entries[rank - first].push_back(entry);
+                }
+            }
+        };
+        int numWorkers = min((int)numThreads, last - first);
+        vector<thread> workers;
+        for (int i = 1; i < numWorkers; i++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (thread& worker : workers) {
+            worker.join();
+        }
+
+        // adding the hubs in order keeps every label sorted by hub
+        for (int rank = first; rank < last; rank++) {
+            const vector<int>& actors = reached[rank - first];
+            for (unsigned int i = 0; i < actors.size(); i++) {
+                built[actors[i]].push_back(entries[rank - first][i]);
+            }
+            numEntries += actors.size();
+        }
+        tooFar = tooFar || numEntries > maxEntries;
+        first = last;
+    }
+    if (tooFar) {
+        return false;
+    }
+
+    // packs the labels one actor after another
+    vector<int> offsets(numActors + 1, 0);
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        offsets[actorId + 1] = offsets[actorId] + built[actorId].size();
+    }
+    vector<int> hubs(offsets[numActors]);
+    vector<unsigned char> distances(offsets[numActors]);
+    vector<int> parents(offsets[numActors]);
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        for (unsigned int i = 0; i < built[actorId].size(); i++) {
+            hubs[offsets[actorId] + i] = built[actorId][i].hub;
+            distances[offsets[actorId] + i] = built[actorId][i].distance;
+            parents[offsets[actorId] + i] = built[actorId][i].parent;
+        }
+        vector<LabelEntry>().swap(built[actorId]);
+    }
+    labels.offsets.assign(move(offsets));
+    labels.hubs.assign(move(hubs));
+    labels.distances.assign(move(distances));
+    labels.parents.assign(move(parents));
+    return true;
+}
+
+/*
+ * Tells if distance labels answer the unweighted searches
+ *
+ * Parameters: None
+ *
+ * Return: true if buildDistanceLabels or the snapshot gave the graph labels
+ */
+bool ActorGraph::hasDistanceLabels() const { return !labels.empty(); }
+
+/*
+ * Finds the first movie two actors were both in
+ *
+ * Parameters:
+ *              adjacency - the movies of every actor, in increasing id
+ *              actorId - one of the actors
+ *              otherId - the other actor
+ *
+ * Return: the id of the movie, -1 if they share none
+ */
+static int sharedMovie(const BipartiteAdjacency& adjacency, int actorId,
+                       int otherId) {
+    int i = adjacency.moviesBegin(actorId);
+    int j = adjacency.moviesBegin(otherId);
+    while (i < adjacency.moviesEnd(actorId) &&
+           j < adjacency.moviesEnd(otherId)) {
+        if (adjacency.actorMovies[i] < adjacency.actorMovies[j]) {
+            i++;
+        } else if (adjacency.actorMovies[i] > adjacency.actorMovies[j]) {
+            j++;
+        } else {
+            return adjacency.actorMovies[i];
+        }
+    }
+    return -1;
+}
+
+/*
+ * Finds a shortest path from the labels alone: the hub the two labels are
+ * closest through is found by merging them, and the next actor of each entry
+ * is followed from both ends to the hub, one hop at a time. The path is laid
+ * out along prev and connector. Of several paths equally short the one found
+ * isn't always the one a one way BFS would find.
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              context - holds the distance, prev and connector of every
+ *                        actor on the path
+ *
+ * Return: true if the end was reached, false otherwise
+ */
+bool ActorGraph::labelSearch(int start, int end,
+                             SearchContext& context) const {
+    int hub;
+    int distance = labels.distance(start, end, hub);
+    if (distance == INT_MAX || distance > context.limit) {
+        return false;
+    }
+
+    // the actors from each end up to the hub, which both of them end with
+    vector<int> fromStart(1, start);
+    vector<int> fromEnd(1, end);
+    for (vector<int>* way : {&fromStart, &fromEnd}) {
+        int parent = labels.parents[labels.find(way->back(), hub)];
+        while (parent != -1) {
+            way->push_back(parent);
+            parent = labels.parents[labels.find(parent, hub)];
+        }
+    }
+    fromStart.insert(fromStart.end(), fromEnd.rbegin() + 1, fromEnd.rend());
+
+    context.reach(start, 0, -1, -1);
+    for (unsigned int i = 1; i < fromStart.size(); i++) {
+        context.reach(fromStart[i], i, fromStart[i - 1],
+                      sharedMovie(bipartiteAdjacency, fromStart[i - 1],
+                                  fromStart[i]));
+    }
+    return true;
+}
+
+/*
+ * Finds the number of hops between two actors, merging their labels when the
+ * graph has them and otherwise searching from both ends
+ *
+ * Parameters:
+ *              firstActor - the name of the first actor
+ *              secondActor - the name of the second actor
+ *
+ * Return: the number of movies on a shortest path between the two, -1 if an
+ * actor doesn't exist or they aren't connected
+ */
+int ActorGraph::unweightedDistance(const string& firstActor,
+                                   const string& secondActor) const {
+    int firstId = actorNames.find(firstActor);
+    int secondId = actorNames.find(secondActor);
+    if (firstId == -1 || secondId == -1) {
+        return -1;
+    }
+    return pairDistance(firstId, secondId, false, threadContext());
+}
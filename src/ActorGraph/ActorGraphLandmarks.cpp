@@ -0,0 +1,126 @@
+/*
+ * ActorGraphLandmarks.cpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ *
+ * Picks the landmark actors of an ActorGraph and stores the weighted distance
+ * from each of them to every actor. By the triangle inequality the distances
+ * bound how far any actor is from the end of a search, which lets a weighted
+ * search head for the end instead of spreading out evenly.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+/*
+ * Picks the landmarks that guide weighted searches farthest first: the actor
+ * in the most movies, then each time the actor farthest from every landmark
+ * picked so far that they reach. A one way Dijkstra from each one stores its
+ * distance to every actor. The landmarks go into the snapshot, and are
+ * dropped when ingest changes the graph.
+ *
+ * Parameters:
+ *              count - the number of landmarks, 0 drops them
+ *
+ * Return: None
+ */
+void ActorGraph::buildLandmarks(int count) {
+    int numActors = nodes.size();
+    count = max(0, min(count, numActors));
+    if (count == 0) {
+        landmarks.clear();
+        landmarkDistances.clear();
+        return;
+    }
+
+    // the actor in the most movies is well connected to start from
+    int next = 0;
+    int mostMovies = -1;
+    for (int actorId = 0; actorId < numActors; actorId++) {
+        int numMovies = bipartiteAdjacency.moviesEnd(actorId) -
+                        bipartiteAdjacency.moviesBegin(actorId);
+        if (numMovies > mostMovies) {
+            next = actorId;
+            mostMovies = numMovies;
+        }
+    }
+
+    vector<int> picked;
+    vector<int> distances((size_t)numActors * count);
+    vector<int> nearest(numActors, INT_MAX);  // to the closest landmark
+    SearchContext context;
+    for (int i = 0; i < count; i++) {
+        picked.push_back(next);
+        context.begin(numActors, getNumMovies());
+        searchFrom(next, vector<int>(), true, context);
+        for (int actorId = 0; actorId < numActors; actorId++) {
+            int distance = context.dist(actorId);
+            distances[(size_t)actorId * count + i] = distance;
+            nearest[actorId] = min(nearest[actorId], distance);
+        }
+
+        // actors no landmark reaches are left out, the landmarks would only
+        // bound searches between them and the landmark's own actors
+        for (int actorId = 0; actorId < numActors; actorId++) {
+            if (nearest[actorId] != INT_MAX &&
+                nearest[actorId] > nearest[next]) {
+                next = actorId;
+            }
+        }
+    }
+    landmarks.assign(move(picked));
+    landmarkDistances.assign(move(distances));
+}
+
+/*
+ * Returns the number of landmarks guiding weighted searches
+ *
+ * Parameters: None
+ *
+ * Return: the number of landmarks, 0 if none were built
+ */
+int ActorGraph::getNumLandmarks() const { return landmarks.size(); }
+
+/*
+ * Picks the landmarks whose distances to the two ends differ the most, since
+ * those give the tightest bounds around the search
+ *
+ * Parameters:
+ *              start - the id of the first actor
+ *              end - the id of the second actor
+ *              guide - set to the landmarks picked
+ *
+ * Return: false if a landmark reaches only one of the two so they aren't
+ * connected, true otherwise
+ */
+bool ActorGraph::guideSearch(int start, int end, LandmarkGuide& guide) const {
+    int numLandmarks = landmarks.size();
+    const int* startRow = &landmarkDistances[(size_t)start * numLandmarks];
+    const int* endRow = &landmarkDistances[(size_t)end * numLandmarks];
+
+    // keeps the landmarks reaching both ends with the widest gap first
+    vector<pair<int, int>> gaps;
+    for (int i = 0; i < numLandmarks; i++) {
+        if (startRow[i] == INT_MAX || endRow[i] == INT_MAX) {
+            if (startRow[i] != endRow[i]) {
+                return false;
+            }
+            continue;
+        }
+        gaps.emplace_back(-abs(startRow[i] - endRow[i]), i);
+    }
+    guide.numActive = min((int)gaps.size(), MAX_ACTIVE_LANDMARKS);
+    partial_sort(gaps.begin(), gaps.begin() + guide.numActive, gaps.end());
+    for (int i = 0; i < guide.numActive; i++) {
+        int landmark = gaps[i].second;
+        guide.landmarkIndices[i] = landmark;
+        guide.startDistances[i] = startRow[landmark];
+        guide.endDistances[i] = endRow[landmark];
+    }
+    return true;
+}
@@ -0,0 +1,392 @@
+/*
+ * ActorGraphSnapshot.cpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ *
+ * Saves a built ActorGraph to a binary snapshot and maps it back in, so a run
+ * over the same movie file can skip reading and building the graph. Every
+ * array of the graph is written as is and borrowed straight from the mapping
+ * on load.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "ActorGraph.hpp"
+
+#define SNAPSHOT_MAGIC "ACTGRAPH"
+#define SNAPSHOT_MAGIC_LENGTH 8
+#define SNAPSHOT_VERSION 5
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+#define SNAPSHOT_ALIGNMENT 8
+
+using namespace std;
+
+// every array in the snapshot, in the order they are written
+enum SnapshotSection {
+    ACTOR_CHARS,
+    ACTOR_STARTS,
+    ACTOR_SLOTS,
+    TITLE_CHARS,
+    TITLE_STARTS,
+    TITLE_SLOTS,
+    MOVIE_TITLE_IDS,
+    MOVIE_YEARS,
+    NAME_RANKS,
+    ACTOR_OFFSETS,
+    ACTOR_MOVIES,
+    MOVIE_OFFSETS,
+    MOVIE_ACTORS,
+    MOVIE_WEIGHTS,
+    CSR_OFFSETS,
+    CSR_NEIGHBORS,
+    CSR_MOVIE_IDS,
+    CSR_WEIGHTS,
+    LANDMARKS,
+    LANDMARK_DISTANCES,
+    HIERARCHY_RANKS,
+    HIERARCHY_OFFSETS,
+    HIERARCHY_TARGETS,
+    HIERARCHY_WEIGHTS,
+    HIERARCHY_MIDDLES,
+    LABEL_OFFSETS,
+    LABEL_HUBS,
+    LABEL_DISTANCES,
+    LABEL_PARENTS,
+    COMPONENTS,
+    NUM_SECTIONS
+};
+
+// the start of the file, the sections follow at the offsets it gives
+struct SnapshotHeader {
+    char magic[SNAPSHOT_MAGIC_LENGTH];
+    unsigned int version;
+    unsigned int byteOrder;  // a different value means another byte order
+    unsigned int bipartite;
+    unsigned int numSections;
+    unsigned long long offsets[NUM_SECTIONS];  // bytes from the file start
+    unsigned long long counts[NUM_SECTIONS];   // elements in each section
+};
+
+// the bytes and number of elements of one section to write
+struct SnapshotArray {
+    const void* data;
+    size_t count;
+    size_t elementSize;
+};
+
+/*
+ * Returns the section of a frozen array to write
+ *
+ * Parameters:
+ *              array - the array to write
+ *
+ * Return: the bytes and number of elements of the array
+ */
+template <typename T>
+static SnapshotArray section(const FrozenArray<T>& array) {
+    SnapshotArray result = {array.data(), array.size(), sizeof(T)};
+    return result;
+}
+
+/*
+ * Rounds the offset up to where the next section may start
+ *
+ * Parameters:
+ *              offset - the byte after the previous section
+ *
+ * Return: the offset aligned for any of the arrays
+ */
+static unsigned long long alignSection(unsigned long long offset) {
+    return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT *
+           SNAPSHOT_ALIGNMENT;
+}
+
+/*
+ * Writes the built graph to a binary snapshot: the interned names, the
+ * movies, the rank of each name, both adjacencies, the landmarks, the
+ * hierarchy, the distance labels and the components, each array aligned so
+ * it can be used in place once mapped back in. Rows grown by ingest are
+ * packed and the components it joined numbered first.
+ *
+ * Parameters:
+ *              filename - the snapshot file to write
+ *
+ * Return: true if the snapshot was written, false otherwise
+ */
+bool ActorGraph::saveSnapshot(const char* filename) {
+    adjacency.pack();
+    bipartiteAdjacency.pack();
+    numberComponents();
+
+    FrozenArray<int> nameRanks;
+    vector<int> ranks(nodes.size());
+    for (unsigned int actorId = 0; actorId < nodes.size(); actorId++) {
+        ranks[actorId] = nodes[actorId]->nameRank;
+    }
+    nameRanks.assign(move(ranks));
+
+    SnapshotArray sections[NUM_SECTIONS] = {
+        section(actorNames.getChars()),
+        section(actorNames.getStarts()),
+        section(actorNames.getSlots()),
+        section(movieTitles.getChars()),
+        section(movieTitles.getStarts()),
+        section(movieTitles.getSlots()),
+        section(movieTitleIds),
+        section(movieYears),
+        section(nameRanks),
+        section(bipartiteAdjacency.actorOffsets),
+        section(bipartiteAdjacency.actorMovies),
+        section(bipartiteAdjacency.movieOffsets),
+        section(bipartiteAdjacency.movieActors),
+        section(bipartiteAdjacency.movieWeights),
+        section(adjacency.offsets),
+        section(adjacency.neighbors),
+        section(adjacency.movieIds),
+        section(adjacency.weights),
+        section(landmarks),
+        section(landmarkDistances),
+        section(hierarchy.ranks),
+        section(hierarchy.offsets),
+        section(hierarchy.targets),
+        section(hierarchy.weights),
+        section(hierarchy.middles),
+        section(labels.offsets),
+        section(labels.hubs),
+        section(labels.distances),
+        section(labels.parents),
+        section(components)};
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LENGTH);
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.bipartite = bipartite;
+    header.numSections = NUM_SECTIONS;
+    unsigned long long offset = alignSection(sizeof(header));
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        header.offsets[i] = offset;
+        header.counts[i] = sections[i].count;
+        offset = alignSection(offset +
+                              sections[i].count * sections[i].elementSize);
+    }
+
+    ofstream outFile(filename, ios::binary | ios::trunc);
+    if (!outFile) {
+        cerr << "Failed to write snapshot " << filename << endl;
+        return false;
+    }
+    outFile.write((const char*)&header, sizeof(header));
+    unsigned long long written = sizeof(header);
+    const char padding[SNAPSHOT_ALIGNMENT] = {0};
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        outFile.write(padding, header.offsets[i] - written);
+        size_t bytes = sections[i].count * sections[i].elementSize;
+        outFile.write((const char*)sections[i].data, bytes);
+        written = header.offsets[i] + bytes;
+    }
+    outFile.write(padding, alignSection(written) - written);
+    outFile.close();
+    if (!outFile) {
+        cerr << "Failed to write snapshot " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Maps a snapshot written by saveSnapshot and points the graph's arrays into
+ * it instead of reading and building the graph again. Only the nodes are
+ * allocated, so the graph is ready to search right away.
+ *
+ * Parameters:
+ *              filename - the snapshot file to map
+ *
+ * Return: true if the snapshot was valid and loaded, false otherwise
+ */
+bool ActorGraph::loadSnapshot(const char* filename) {
+    // drops the graph built so far, nothing may borrow from the old mapping
+    for (unsigned int i = 0; i < nodes.size(); i++) {
+        delete nodes[i];
+    }
+    nodes.clear();
+    actorNames.borrow(NULL, 0, NULL, 0, NULL, 0);
+    movieTitles.borrow(NULL, 0, NULL, 0, NULL, 0);
+    movieIds.clear();
+    movieTitleIds.clear();
+    movieYears.clear();
+    movieCasts.clear();
+    adjacency.clear();
+    bipartiteAdjacency.clear();
+    pathCache.clear();
+    landmarks.clear();
+    landmarkDistances.clear();
+    hierarchy.clear();
+    labels.clear();
+    components.clear();
+    componentParents.clear();
+    componentsStale = false;
+    neighborMapsBuilt = false;
+    weightedMapsBuilt = false;
+
+    if (!snapshotFile.open(filename)) {
+        cerr << "Failed to read snapshot " << filename << endl;
+        return false;
+    }
+
+    // checks the header before trusting any of the offsets in it
+    const char* base = snapshotFile.data();
+    SnapshotHeader header;
+    if (snapshotFile.size() < sizeof(header)) {
+        cerr << "Snapshot " << filename << " is truncated" << endl;
+        snapshotFile.close();
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LENGTH) != 0 ||
+        header.version != SNAPSHOT_VERSION ||
+        header.byteOrder != SNAPSHOT_BYTE_ORDER ||
+        header.numSections != NUM_SECTIONS) {
+        cerr << "Snapshot " << filename << " is not a snapshot this version "
+             << "can read" << endl;
+        snapshotFile.close();
+        return false;
+    }
+    const size_t elementSizes[NUM_SECTIONS] = {
+        sizeof(char), sizeof(unsigned int), sizeof(int),
+        sizeof(char), sizeof(unsigned int), sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(int),  sizeof(int),          sizeof(int),
+        sizeof(unsigned char), sizeof(int), sizeof(int)};
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        if (header.offsets[i] % SNAPSHOT_ALIGNMENT != 0 ||
+            header.offsets[i] > snapshotFile.size() ||
+            header.counts[i] > (snapshotFile.size() - header.offsets[i]) /
+                                   elementSizes[i]) {
+            cerr << "Snapshot " << filename << " is truncated" << endl;
+            snapshotFile.close();
+            return false;
+        }
+    }
+
+    // the sizes of the arrays have to agree with each other
+    const unsigned long long* counts = header.counts;
+    unsigned long long numActors = counts[NAME_RANKS];
+    unsigned long long numMovies = counts[MOVIE_YEARS];
+    unsigned long long numCSR = counts[CSR_OFFSETS];
+    if (counts[ACTOR_STARTS] != (numActors ? numActors + 1 : 0) ||
+        counts[ACTOR_OFFSETS] != numActors + 1 ||
+        counts[MOVIE_TITLE_IDS] != numMovies ||
+        counts[MOVIE_OFFSETS] != numMovies + 1 ||
+        counts[MOVIE_WEIGHTS] != numMovies ||
+        counts[ACTOR_MOVIES] != counts[MOVIE_ACTORS] ||
+        (numCSR != 0 && numCSR != numActors + 1) ||
+        counts[CSR_NEIGHBORS] != counts[CSR_MOVIE_IDS] ||
+        counts[CSR_NEIGHBORS] != counts[CSR_WEIGHTS] ||
+        counts[LANDMARK_DISTANCES] != counts[LANDMARKS] * numActors ||
+        (counts[HIERARCHY_RANKS] != 0 &&
+         counts[HIERARCHY_RANKS] != numActors + numMovies) ||
+        counts[HIERARCHY_OFFSETS] !=
+            (counts[HIERARCHY_RANKS] ? numActors + numMovies + 1 : 0) ||
+        counts[HIERARCHY_TARGETS] != counts[HIERARCHY_WEIGHTS] ||
+        counts[HIERARCHY_TARGETS] != counts[HIERARCHY_MIDDLES] ||
+        (counts[LABEL_OFFSETS] != 0 &&
+         counts[LABEL_OFFSETS] != numActors + 1) ||
+        counts[LABEL_HUBS] != counts[LABEL_DISTANCES] ||
+        counts[LABEL_HUBS] != counts[LABEL_PARENTS] ||
+        (counts[COMPONENTS] != 0 && counts[COMPONENTS] != numActors)) {
+        cerr << "Snapshot " << filename << " is inconsistent" << endl;
+        snapshotFile.close();
+        return false;
+    }
+
+    // every array is used in place from the mapping
+    const char* sections[NUM_SECTIONS];
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        sections[i] = base + header.offsets[i];
+    }
+
+    // the forest hangs each actor under the first of its component, so the
+    // components have to be numbered in order of their first actor
+    const int* componentIds = (const int*)sections[COMPONENTS];
+    componentParents.resize(counts[COMPONENTS]);
+    vector<int> firstActors;
+    for (unsigned int actorId = 0; actorId < counts[COMPONENTS]; actorId++) {
+        int componentId = componentIds[actorId];
+        if (componentId == (int)firstActors.size()) {
+            firstActors.push_back(actorId);
+        } else if (componentId < 0 || componentId > (int)firstActors.size()) {
+            cerr << "Snapshot " << filename << " is inconsistent" << endl;
+            componentParents.clear();
+            snapshotFile.close();
+            return false;
+        }
+        componentParents[actorId] = firstActors[componentId];
+    }
+    actorNames.borrow(sections[ACTOR_CHARS], counts[ACTOR_CHARS],
+                      (const unsigned int*)sections[ACTOR_STARTS],
+                      counts[ACTOR_STARTS], (const int*)sections[ACTOR_SLOTS],
+                      counts[ACTOR_SLOTS]);
+    movieTitles.borrow(sections[TITLE_CHARS], counts[TITLE_CHARS],
+                       (const unsigned int*)sections[TITLE_STARTS],
+                       counts[TITLE_STARTS], (const int*)sections[TITLE_SLOTS],
+                       counts[TITLE_SLOTS]);
+    movieTitleIds.borrow((const int*)sections[MOVIE_TITLE_IDS], numMovies);
+    movieYears.borrow((const int*)sections[MOVIE_YEARS], numMovies);
+    bipartiteAdjacency.actorOffsets.borrow(
+        (const int*)sections[ACTOR_OFFSETS], counts[ACTOR_OFFSETS]);
+    bipartiteAdjacency.actorMovies.borrow((const int*)sections[ACTOR_MOVIES],
+                                          counts[ACTOR_MOVIES]);
+    bipartiteAdjacency.movieOffsets.borrow(
+        (const int*)sections[MOVIE_OFFSETS], counts[MOVIE_OFFSETS]);
+    bipartiteAdjacency.movieActors.borrow((const int*)sections[MOVIE_ACTORS],
+                                          counts[MOVIE_ACTORS]);
+    bipartiteAdjacency.movieWeights.borrow(
+        (const int*)sections[MOVIE_WEIGHTS], counts[MOVIE_WEIGHTS]);
+    adjacency.offsets.borrow((const int*)sections[CSR_OFFSETS], numCSR);
+    adjacency.neighbors.borrow((const int*)sections[CSR_NEIGHBORS],
+                               counts[CSR_NEIGHBORS]);
+    adjacency.movieIds.borrow((const int*)sections[CSR_MOVIE_IDS],
+                              counts[CSR_MOVIE_IDS]);
+    adjacency.weights.borrow((const int*)sections[CSR_WEIGHTS],
+                             counts[CSR_WEIGHTS]);
+    landmarks.borrow((const int*)sections[LANDMARKS], counts[LANDMARKS]);
+    landmarkDistances.borrow((const int*)sections[LANDMARK_DISTANCES],
+                             counts[LANDMARK_DISTANCES]);
+    hierarchy.ranks.borrow((const int*)sections[HIERARCHY_RANKS],
+                           counts[HIERARCHY_RANKS]);
+    hierarchy.offsets.borrow((const int*)sections[HIERARCHY_OFFSETS],
+                             counts[HIERARCHY_OFFSETS]);
+    hierarchy.targets.borrow((const int*)sections[HIERARCHY_TARGETS],
+                             counts[HIERARCHY_TARGETS]);
+    hierarchy.weights.borrow((const int*)sections[HIERARCHY_WEIGHTS],
+                             counts[HIERARCHY_WEIGHTS]);
+    hierarchy.middles.borrow((const int*)sections[HIERARCHY_MIDDLES],
+                             counts[HIERARCHY_MIDDLES]);
+    labels.offsets.borrow((const int*)sections[LABEL_OFFSETS],
+                          counts[LABEL_OFFSETS]);
+    labels.hubs.borrow((const int*)sections[LABEL_HUBS], counts[LABEL_HUBS]);
+    labels.distances.borrow(
+        (const unsigned char*)sections[LABEL_DISTANCES],
+        counts[LABEL_DISTANCES]);
+    labels.parents.borrow((const int*)sections[LABEL_PARENTS],
+                          counts[LABEL_PARENTS]);
+    components.borrow((const int*)sections[COMPONENTS], counts[COMPONENTS]);
+    bipartite = header.bipartite != 0;
+
+    // the nodes only hold the search state and the rank of each name
+    const int* nameRanks = (const int*)sections[NAME_RANKS];
+    nodes.resize(numActors);
+    for (unsigned int actorId = 0; actorId < numActors; actorId++) {
+        nodes[actorId] = new ActorNode(actorId);
+        nodes[actorId]->nameRank = nameRanks[actorId];
+    }
+    return true;
+}
@@ -0,0 +1,114 @@
+/**
+ * BipartiteAdjacency.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: The actor-movie view of the graph where movies are nodes of
+ * their own. Each actor only links to its movies and each movie to its cast,
+ * so building it is linear in the number of rows instead of quadratic in the
+ * size of each cast. Both halves can still grow when rows are ingested into
+ * a built graph.
+ * Sources: Piazza
+ */
+#ifndef BIPARTITEADJACENCY_HPP
+#define BIPARTITEADJACENCY_HPP
+
+#include "FrozenArray.hpp"
+#include "GrowableRows.hpp"
+
+using namespace std;
+
+/**
+ * Two compressed sparse row halves. The movies of actor id `a` are
+ * actorMovies[moviesBegin(a) .. moviesEnd(a)) and the cast of movie id `m` is
+ * movieActors[castBegin(m) .. castEnd(m)).
+ */
+struct BipartiteAdjacency {
+    FrozenArray<int> actorOffsets;  // size is the number of actors plus one
+    FrozenArray<int> actorMovies;   // the movies of each actor as added
+    FrozenArray<int> movieOffsets;  // size is the number of movies plus one
+    FrozenArray<int> movieActors;   // the cast of each movie in the order read
+    FrozenArray<int> movieWeights;  // the weight of each movie
+    GrowableRows actorRows;         // the room each actor has to grow into
+    GrowableRows movieRows;         // the room each cast has to grow into
+
+    /* Returns the index of the first movie of the actor */
+    int moviesBegin(int actorId) const { return actorOffsets[actorId]; }
+
+    /* Returns the index one past the last movie of the actor */
+    int moviesEnd(int actorId) const {
+        return actorRows.end(actorOffsets, actorId);
+    }
+
+    /* Returns the index of the first actor in the cast of the movie */
+    int castBegin(int movieId) const { return movieOffsets[movieId]; }
+
+    /* Returns the index one past the last actor in the cast of the movie */
+    int castEnd(int movieId) const {
+        return movieRows.end(movieOffsets, movieId);
+    }
+
+    /* Returns the number of actors the adjacency was built for */
+    int numActors() const {
+        return actorOffsets.empty() ? 0 : (int)actorOffsets.size() - 1;
+    }
+
+    /* Returns the number of movies the adjacency was built for */
+    int numMovies() const {
+        return movieOffsets.empty() ? 0 : (int)movieOffsets.size() - 1;
+    }
+
+    /* Returns the number of roles, one per actor in each cast */
+    int numRoles() const { return actorRows.count(actorOffsets); }
+
+    /* Adds an actor without any movies */
+    void addActor() { actorRows.addRow(actorOffsets); }
+
+    /* Adds a movie of the given weight without a cast */
+    void addMovie(int weight) {
+        movieRows.addRow(movieOffsets);
+        movieWeights.edit().push_back(weight);
+    }
+
+    /*
+     * Adds the actor to the end of the movie's cast and the movie to the end
+     * of the actor's movies
+     *
+     * Parameters:
+     *              actorId - the actor in the movie
+     *              movieId - the movie the actor is in
+     *
+     * Return: None
+     */
+    void addRole(int actorId, int movieId) {
+        int role = actorRows.addEntry(actorOffsets, actorId, {&actorMovies});
+        actorMovies.edit()[role] = movieId;
+        int member = movieRows.addEntry(movieOffsets, movieId, {&movieActors});
+        movieActors.edit()[member] = actorId;
+    }
+
+    /* Tells if the gaps left by growing take up more room than the roles */
+    bool sparse() const {
+        return actorRows.sparse(actorOffsets) || movieRows.sparse(movieOffsets);
+    }
+
+    /* Packs both halves back to back, keeping the order within each row */
+    void pack() {
+        actorRows.pack(actorOffsets, {&actorMovies});
+        movieRows.pack(movieOffsets, {&movieActors});
+    }
+
+    /* Releases all of the arrays */
+    void clear() {
+        actorOffsets.clear();
+        actorMovies.clear();
+        movieOffsets.clear();
+        movieActors.clear();
+        movieWeights.clear();
+        actorRows.clear();
+        movieRows.clear();
+    }
+};
+
+#endif
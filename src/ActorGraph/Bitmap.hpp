@@ -0,0 +1,59 @@
+/**
+ * Bitmap.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: One bit for each actor, packed 64 to a word, for the sets of
+ * actors a BFS checks against most often. A whole level of a search fits in
+ * a few cache lines, and the actors left out of a set are found a word at a
+ * time.
+ * Sources: Piazza
+ */
+#ifndef BITMAP_HPP
+#define BITMAP_HPP
+
+#include <vector>
+
+#define BITS_PER_WORD 64
+
+using namespace std;
+
+/**
+ * The bits are kept between uses so a bitmap used again doesn't allocate
+ */
+class Bitmap {
+  private:
+    vector<unsigned long long> words;
+
+  public:
+    /*
+     * Clears the bitmap, making room for the given number of bits
+     *
+     * Parameters:
+     *              numBits - the number of bits
+     *
+     * Return: None
+     */
+    void reset(int numBits) {
+        words.assign((numBits + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    }
+
+    /* Sets the bit */
+    void set(int bit) {
+        words[bit / BITS_PER_WORD] |= 1ULL << (bit % BITS_PER_WORD);
+    }
+
+    /* Tells if the bit is set */
+    bool test(int bit) const {
+        return (words[bit / BITS_PER_WORD] >> (bit % BITS_PER_WORD)) & 1;
+    }
+
+    /* Returns the number of words */
+    int numWords() const { return words.size(); }
+
+    /* Returns the word holding bits [index * 64, index * 64 + 64) */
+    unsigned long long word(int index) const { return words[index]; }
+};
+
+#endif
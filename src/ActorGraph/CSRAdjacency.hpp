@@ -0,0 +1,85 @@
+/**
+ * CSRAdjacency.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: A frozen compressed sparse row view of the actor graph. Every
+ * actor's neighbors live in one contiguous slice of the arrays so the searches
+ * walk flat memory instead of the nested hash maps on each ActorNode. Rows
+ * can still grow when rows are ingested into a built graph.
+ * Sources: Piazza
+ */
+#ifndef CSRADJACENCY_HPP
+#define CSRADJACENCY_HPP
+
+#include "FrozenArray.hpp"
+#include "GrowableRows.hpp"
+
+using namespace std;
+
+/**
+ * The adjacency of the graph. The neighbors of actor id `a` are the entries in
+ * [begin(a), end(a)) of the three parallel arrays, which is
+ * [offsets[a], offsets[a + 1]) until an edge is added after the build.
+ */
+struct CSRAdjacency {
+    FrozenArray<int> offsets;    // size is the number of actors plus one
+    FrozenArray<int> neighbors;  // the actor id on the other end of each edge
+    FrozenArray<int> movieIds;   // the movie that relates the two actors
+    FrozenArray<int> weights;    // the weight of the movie of each edge
+    GrowableRows rows;           // the room each actor has to grow into
+
+    /* Returns the index of the first edge of the actor */
+    int begin(int actorId) const { return offsets[actorId]; }
+
+    /* Returns the index one past the last edge of the actor */
+    int end(int actorId) const { return rows.end(offsets, actorId); }
+
+    /* Returns the number of edges leaving the actor */
+    int degree(int actorId) const { return end(actorId) - begin(actorId); }
+
+    /* Returns the number of actors the adjacency was built for */
+    int numActors() const {
+        return offsets.empty() ? 0 : (int)offsets.size() - 1;
+    }
+
+    /* Adds an actor without any edges */
+    void addActor() { rows.addRow(offsets); }
+
+    /*
+     * Adds an edge after the last edge of the actor
+     *
+     * Parameters:
+     *              actorId - the actor the edge leaves
+     *              neighborId - the actor on the other end
+     *              movieId - the movie that relates the two actors
+     *              weight - the weight of the movie
+     *
+     * Return: None
+     */
+    void addEdge(int actorId, int neighborId, int movieId, int weight) {
+        int edge =
+            rows.addEntry(offsets, actorId, {&neighbors, &movieIds, &weights});
+        neighbors.edit()[edge] = neighborId;
+        movieIds.edit()[edge] = movieId;
+        weights.edit()[edge] = weight;
+    }
+
+    /* Tells if the gaps left by growing take up more room than the edges */
+    bool sparse() const { return rows.sparse(offsets); }
+
+    /* Packs the edges of every actor back to back, keeping their order */
+    void pack() { rows.pack(offsets, {&neighbors, &movieIds, &weights}); }
+
+    /* Releases all of the arrays */
+    void clear() {
+        offsets.clear();
+        neighbors.clear();
+        movieIds.clear();
+        weights.clear();
+        rows.clear();
+    }
+};
+
+#endif
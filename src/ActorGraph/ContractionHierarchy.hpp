@@ -0,0 +1,84 @@
+/**
+ * ContractionHierarchy.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: A contraction hierarchy over the actors and movies of the
+ * graph, each actor linked to each of its movies by the movie's weight. The
+ * nodes were contracted one at a time, and a shortcut stands in for every
+ * shortest path that went through a node contracted before both of its ends.
+ * Every shortest path then climbs up the order from both ends, so a query
+ * only searches upward until it reaches the core left uncontracted at the
+ * top.
+ * Sources: Piazza
+ */
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include <utility>
+#include "FrozenArray.hpp"
+
+using namespace std;
+
+/**
+ * The upward edges of the hierarchy. Node ids are the actor ids followed by
+ * the movie ids offset by the number of actors. The edges of node `n` are the
+ * entries in [offsets[n], offsets[n + 1]) of the parallel arrays, each to a
+ * node contracted after `n` or, for a node in the core, to every other node
+ * in the core it is linked to. The core nodes all rank at the number of
+ * nodes, past every node contracted. An edge is either an actor's role in a
+ * movie or a shortcut through the middle node, which has an edge up to each
+ * end.
+ */
+struct ContractionHierarchy {
+    FrozenArray<int> ranks;    // the position of each node, core ones last
+    FrozenArray<int> offsets;  // size is the number of nodes plus one
+    FrozenArray<int> targets;  // the other node of each edge
+    FrozenArray<int> weights;  // the weight of the path the edge stands for
+    FrozenArray<int> middles;  // the node a shortcut skips, -1 for a role
+
+    /* Returns the index of the first upward edge of the node */
+    int begin(int node) const { return offsets[node]; }
+
+    /* Returns the index one past the last upward edge of the node */
+    int end(int node) const { return offsets[node + 1]; }
+
+    /* Tells if the node was left uncontracted in the core */
+    bool inCore(int node) const { return ranks[node] == (int)ranks.size(); }
+
+    /* Tells if no hierarchy was built */
+    bool empty() const { return ranks.empty(); }
+
+    /*
+     * Finds the edge between two nodes of the hierarchy
+     *
+     * Parameters:
+     *              node - one end of the edge
+     *              other - the other end of the edge
+     *
+     * Return: the index of the edge, -1 if they aren't linked
+     */
+    int findEdge(int node, int other) const {
+        if (ranks[node] > ranks[other]) {
+            swap(node, other);
+        }
+        for (int edge = begin(node); edge < end(node); edge++) {
+            if (targets[edge] == other) {
+                return edge;
+            }
+        }
+        return -1;
+    }
+
+    /* Releases all of the arrays */
+    void clear() {
+        ranks.clear();
+        offsets.clear();
+        targets.clear();
+        weights.clear();
+        middles.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * DistanceLabels.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: Two hop labels giving the exact number of hops between any two
+ * actors. Each actor keeps the hop count to a few hub actors, and every
+ * shortest path between two actors passes through a hub they both keep, so
+ * their distance is the lightest sum over the hubs their labels share. Each
+ * entry also keeps the next actor toward its hub, whose own label has the
+ * hub one hop closer, so the path through the hub can be followed too.
+ * Sources: Piazza
+ */
+#ifndef DISTANCELABELS_HPP
+#define DISTANCELABELS_HPP
+
+#include <algorithm>
+#include <climits>
+#include "FrozenArray.hpp"
+
+#define MAX_LABEL_DISTANCE 254
+
+using namespace std;
+
+/**
+ * One entry of an actor's label while the labels are being built
+ */
+struct LabelEntry {
+    int hub;                 // the position of the hub in the order
+    unsigned char distance;  // the hops to the hub
+    int parent;              // the next actor toward the hub, -1 for it
+};
+
+/**
+ * The label of actor id `a` is the entries in [offsets[a], offsets[a + 1]) of
+ * the parallel arrays, sorted by the position of each hub in the order the
+ * labels were built in, so two labels are merged in one pass.
+ */
+struct DistanceLabels {
+    FrozenArray<int> offsets;  // size is the number of actors plus one
+    FrozenArray<int> hubs;     // the position of the hub of each entry
+    FrozenArray<unsigned char> distances;  // the hops to the hub
+    FrozenArray<int> parents;  // the next actor toward the hub, -1 for it
+
+    /* Returns the index of the first entry of the actor's label */
+    int begin(int actorId) const { return offsets[actorId]; }
+
+    /* Returns the index one past the last entry of the actor's label */
+    int end(int actorId) const { return offsets[actorId + 1]; }
+
+    /* Tells if no labels were built */
+    bool empty() const { return offsets.empty(); }
+
+    /*
+     * Finds the entry of the hub in the actor's label
+     *
+     * Parameters:
+     *              actorId - the actor whose label to look in
+     *              hub - the position of the hub
+     *
+     * Return: the index of the entry, the end of the label if it has none
+     */
+    int find(int actorId, int hub) const {
+        const int* first = hubs.data() + begin(actorId);
+        const int* last = hubs.data() + end(actorId);
+        const int* entry = lower_bound(first, last, hub);
+        return entry != last && *entry == hub ? entry - hubs.data()
+                                              : end(actorId);
+    }
+
+    /*
+     * Merges the labels of two actors for the hub closest to both
+     *
+     * Parameters:
+     *              actorId - one of the actors
+     *              otherId - the other actor
+     *              hub - set to the position of the hub the two are closest
+     *                    through, the first of them if several are
+     *
+     * Return: the number of hops between the two, INT_MAX if they aren't
+     * connected
+     */
+    int distance(int actorId, int otherId, int& hub) const {
+        int best = INT_MAX;
+        int i = begin(actorId);
+        int j = begin(otherId);
+        while (i < end(actorId) && j < end(otherId)) {
+            if (hubs[i] < hubs[j]) {
+                i++;
+            } else if (hubs[i] > hubs[j]) {
+                j++;
+            } else {
+                int hops = distances[i] + distances[j];
+                if (hops < best) {
+                    best = hops;
+                    hub = hubs[i];
+                }
+                i++;
+                j++;
+            }
+        }
+        return best;
+    }
+
+    /* Returns the number of hops between two actors, INT_MAX if none */
+    int distance(int actorId, int otherId) const {
+        int hub;
+        return distance(actorId, otherId, hub);
+    }
+
+    /* Releases all of the arrays */
+    void clear() {
+        offsets.clear();
+        hubs.clear();
+        distances.clear();
+        parents.clear();
+    }
+};
+
+#endif
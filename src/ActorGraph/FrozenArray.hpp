@@ -0,0 +1,118 @@
+/**
+ * FrozenArray.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: A read-only array that either owns its elements or borrows
+ * them from a memory-mapped snapshot, so the graph's arrays can be used in
+ * place straight out of the file without being parsed or copied.
+ * Sources: Piazza
+ */
+#ifndef FROZENARRAY_HPP
+#define FROZENARRAY_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The elements are read through data() whichever way they are stored. Editing
+ * a borrowed array first copies it into memory the array owns.
+ */
+template <typename T>
+class FrozenArray {
+  private:
+    vector<T> owned;      // the elements when they were built in memory
+    const T* borrowed;    // the elements when they live in a mapped file
+    size_t borrowedSize;  // the number of borrowed elements
+    bool isBorrowed;      // which of the two holds the elements
+
+  public:
+    /* Constructor that starts out as an empty owned array */
+    FrozenArray() : borrowed(NULL), borrowedSize(0), isBorrowed(false) {}
+
+    FrozenArray(const FrozenArray&) = delete;
+    FrozenArray& operator=(const FrozenArray&) = delete;
+
+    /* Returns the first element */
+    const T* data() const { return isBorrowed ? borrowed : owned.data(); }
+
+    /* Returns the number of elements */
+    size_t size() const { return isBorrowed ? borrowedSize : owned.size(); }
+
+    /* Returns true if there are no elements */
+    bool empty() const { return size() == 0; }
+
+    /* Returns the element at the index */
+    const T& operator[](size_t index) const { return data()[index]; }
+
+    /* Returns the last element */
+    const T& back() const { return data()[size() - 1]; }
+
+    /* Returns the first element for range loops */
+    const T* begin() const { return data(); }
+
+    /* Returns one past the last element for range loops */
+    const T* end() const { return data() + size(); }
+
+    /* Tells if the elements live in a mapped file */
+    bool borrowing() const { return isBorrowed; }
+
+    /*
+     * Gives the elements to edit, copying them out of the mapped file first
+     * if they were borrowed
+     *
+     * Parameters: None
+     *
+     * Return: the elements the array owns
+     */
+    vector<T>& edit() {
+        if (isBorrowed) {
+            owned.assign(borrowed, borrowed + borrowedSize);
+            borrowed = NULL;
+            borrowedSize = 0;
+            isBorrowed = false;
+        }
+        return owned;
+    }
+
+    /*
+     * Takes over the given elements
+     *
+     * Parameters:
+     *              elements - the elements to own
+     *
+     * Return: None
+     */
+    void assign(vector<T>&& elements) {
+        owned = move(elements);
+        borrowed = NULL;
+        borrowedSize = 0;
+        isBorrowed = false;
+    }
+
+    /*
+     * Points the array at elements owned by someone else, which must outlive
+     * the array or the next assign
+     *
+     * Parameters:
+     *              elements - the first element
+     *              size - the number of elements
+     *
+     * Return: None
+     */
+    void borrow(const T* elements, size_t size) {
+        vector<T>().swap(owned);
+        borrowed = elements;
+        borrowedSize = size;
+        isBorrowed = true;
+    }
+
+    /* Releases the elements */
+    void clear() { assign(vector<T>()); }
+};
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * GrowableRows.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: Lets the rows of a compressed sparse row layout grow after it
+ * was built. A row that runs out of room moves to the end of the arrays with
+ * twice the room, so adding an entry costs the same on average no matter how
+ * big the layout is. Packing the rows back together drops the gaps left
+ * behind.
+ * Sources: Piazza
+ */
+#ifndef GROWABLEROWS_HPP
+#define GROWABLEROWS_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+#include "FrozenArray.hpp"
+
+#define MIN_ROW_ROOM 4
+
+using namespace std;
+
+/**
+ * Where each row ends and how far it may grow. While the rows are packed
+ * back to back neither is needed, row `r` ends where row `r + 1` begins.
+ */
+struct GrowableRows {
+    vector<int> ends;    // one past the last entry of each row
+    vector<int> limits;  // one past the last slot the row may use
+    bool loose;          // true once a row was given room to grow
+    int numEntries;      // the entries in use, leaving out the gaps
+
+    /* Constructor that starts out packed */
+    GrowableRows() : loose(false), numEntries(0) {}
+
+    /* Returns one past the last entry of the row */
+    int end(const FrozenArray<int>& offsets, int row) const {
+        return loose ? ends[row] : offsets[row + 1];
+    }
+
+    /*
+     * Starts tracking the end and limit of each row of a packed layout
+     *
+     * Parameters:
+     *              offsets - where each row begins, then the used size
+     *
+     * Return: None
+     */
+    void loosen(const FrozenArray<int>& offsets) {
+        if (loose) {
+            return;
+        }
+        if (offsets.empty()) {
+            ends.clear();
+        } else {
+            ends.assign(offsets.begin() + 1, offsets.end());
+        }
+        limits = ends;
+        numEntries = offsets.empty() ? 0 : offsets.back();
+        loose = true;
+    }
+
+    /*
+     * Adds an empty row after the last one
+     *
+     * Parameters:
+     *              offsets - where each row begins, then the used size
+     *
+     * Return: None
+     */
+    void addRow(FrozenArray<int>& offsets) {
+        loosen(offsets);
+        vector<int>& begins = offsets.edit();
+        if (begins.empty()) {
+            begins.push_back(0);
+        }
+        int tail = begins.back();
+        begins.push_back(tail);
+        ends.push_back(tail);
+        limits.push_back(tail);
+    }
+
+    /*
+     * Finds the slot for one more entry of the row. A full row first moves to
+     * the end of the arrays with twice its room, carrying its entries along
+     * in every value array.
+     *
+     * Parameters:
+     *              offsets - where each row begins, then the used size
+     *              row - the row to add an entry to
+     *              values - every array holding one value per slot
+     *
+     * Return: the slot to write the new entry's values to
+     */
+    int addEntry(FrozenArray<int>& offsets, int row,
+                 initializer_list<FrozenArray<int>*> values) {
+        loosen(offsets);
+        vector<int>& begins = offsets.edit();
+        if (ends[row] == limits[row]) {
+            int first = begins[row];
+            int length = ends[row] - first;
+            int tail = begins.back();
+            int room = max(MIN_ROW_ROOM, 2 * length);
+            for (FrozenArray<int>* array : values) {
+                vector<int>& slots = array->edit();
+                slots.resize(tail + room);
+                copy(slots.begin() + first, slots.begin() + first + length,
+                     slots.begin() + tail);
+            }
+            begins[row] = tail;
+            ends[row] = tail + length;
+            limits[row] = tail + room;
+            begins.back() = tail + room;
+        }
+        numEntries++;
+        return ends[row]++;
+    }
+
+    /*
+     * Packs the rows back to back in row order, keeping the order of the
+     * entries within each row and dropping the gaps
+     *
+     * Parameters:
+     *              offsets - where each row begins, then the used size
+     *              values - every array holding one value per slot
+     *
+     * Return: None
+     */
+    void pack(FrozenArray<int>& offsets,
+              initializer_list<FrozenArray<int>*> values) {
+        if (!loose) {
+            return;
+        }
+        int numRows = ends.size();
+        vector<int> packedOffsets(numRows + 1, 0);
+        for (int row = 0; row < numRows; row++) {
+            packedOffsets[row + 1] =
+                packedOffsets[row] + ends[row] - offsets[row];
+        }
+        for (FrozenArray<int>* array : values) {
+            vector<int> packed(packedOffsets.back());
+            for (int row = 0; row < numRows; row++) {
+                copy(array->begin() + offsets[row], array->begin() + ends[row],
+                     packed.begin() + packedOffsets[row]);
+            }
+            array->assign(move(packed));
+        }
+        offsets.assign(move(packedOffsets));
+        clear();
+    }
+
+    /* Returns the entries in use, leaving out the gaps */
+    int count(const FrozenArray<int>& offsets) const {
+        if (loose) {
+            return numEntries;
+        }
+        return offsets.empty() ? 0 : offsets.back();
+    }
+
+    /* Tells if the gaps take up more room than the entries */
+    bool sparse(const FrozenArray<int>& offsets) const {
+        return loose && !offsets.empty() &&
+               offsets.back() - numEntries > numEntries;
+    }
+
+    /* Forgets the ends and limits, for a layout that was just packed */
+    void clear() {
+        ends.clear();
+        limits.clear();
+        loose = false;
+        numEntries = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * MappedFile.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: Maps a whole file read-only into memory and unmaps it when done,
+ * so a snapshot's arrays can be read straight from the page cache.
+ * Sources: Piazza
+ */
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * A read-only mapping of a file that lasts until close or the destructor.
+ */
+class MappedFile {
+  private:
+    const char* mapped;  // the first byte of the file, NULL if none is open
+    size_t mappedSize;   // the number of bytes mapped
+
+  public:
+    /* Constructor that starts out without a file */
+    MappedFile() : mapped(NULL), mappedSize(0) {}
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /* Destructor that unmaps the file */
+    ~MappedFile() { close(); }
+
+    /*
+     * Maps the whole file, unmapping any file mapped before
+     *
+     * Parameters:
+     *              filename - the file to map
+     *
+     * Return: true if the file was mapped, false if it couldn't be opened.
+     * An empty file has no bytes to map and gives a NULL data.
+     */
+    bool open(const char* filename) {
+        close();
+        int descriptor = ::open(filename, O_RDONLY);
+        if (descriptor < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) != 0) {
+            ::close(descriptor);
+            return false;
+        }
+        if (status.st_size == 0) {
+            ::close(descriptor);
+            return true;
+        }
+        void* address = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE,
+                             descriptor, 0);
+        // the mapping keeps the file alive once the descriptor is closed
+        ::close(descriptor);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        mapped = (const char*)address;
+        mappedSize = status.st_size;
+        return true;
+    }
+
+    /* Unmaps the file if one is mapped */
+    void close() {
+        if (mapped != NULL) {
+            munmap((void*)mapped, mappedSize);
+            mapped = NULL;
+            mappedSize = 0;
+        }
+    }
+
+    /* Tells the kernel the file will be read once from front to back */
+    void adviseSequential() const {
+        if (mapped != NULL) {
+            madvise((void*)mapped, mappedSize, MADV_SEQUENTIAL);
+        }
+    }
+
+    /* Returns the first byte of the file */
+    const char* data() const { return mapped; }
+
+    /* Returns the number of bytes in the file */
+    size_t size() const { return mappedSize; }
+};
+
+#endif
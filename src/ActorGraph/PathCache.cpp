@@ -0,0 +1,311 @@
+/*
+ * PathCache.cpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ *
+ * Keeps the least recently used paths in order and writes them to a binary
+ * file next to the graph's snapshot, so a later run over the same graph starts
+ * out with the paths asked for before.
+ */
+
+#include "PathCache.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#define PATH_CACHE_MAGIC "PATHCACH"
+#define PATH_CACHE_MAGIC_LENGTH 8
+#define PATH_CACHE_VERSION 1
+#define PATH_CACHE_BYTE_ORDER 0x01020304u
+#define PATH_CACHE_ENTRY_OVERHEAD 64
+
+using namespace std;
+
+// the start of the file, every entry's key, length and ids follow
+struct PathCacheHeader {
+    char magic[PATH_CACHE_MAGIC_LENGTH];
+    unsigned int version;
+    unsigned int byteOrder;  // a different value means another byte order
+    unsigned long long fingerprint;
+    unsigned long long numEntries;
+};
+
+/*
+ * Returns roughly how many bytes an entry of the path takes up, counting the
+ * list and index nodes holding it
+ *
+ * Parameters:
+ *              path - the path of the entry
+ *
+ * Return: the bytes of the entry
+ */
+size_t PathCache::entryBytes(const vector<int>& path) {
+    return sizeof(CacheEntry) + PATH_CACHE_ENTRY_OVERHEAD +
+           path.size() * sizeof(int);
+}
+
+/*
+ * Drops the least recently used entries until the cap is met, the lock must
+ * be held
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void PathCache::evict() {
+    while (usedBytes > capacity && !entries.empty()) {
+        usedBytes -= entryBytes(entries.back().path);
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+/*
+ * Adds or refreshes the entry of the key as the most recently used, the lock
+ * must be held
+ *
+ * Parameters:
+ *              entryKey - the key of the pair and mode
+ *              path - the path of the pair
+ *
+ * Return: None
+ */
+void PathCache::store(unsigned long long entryKey, const vector<int>& path) {
+    auto found = index.find(entryKey);
+    if (found != index.end()) {
+        usedBytes -= entryBytes(found->second->path);
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    entries.push_front({entryKey, path});
+    index[entryKey] = entries.begin();
+    usedBytes += entryBytes(path);
+    evict();
+}
+
+/*
+ * Sets how many bytes the cache may use, dropping the least recently used
+ * paths that no longer fit
+ *
+ * Parameters:
+ *              bytes - the memory cap, 0 turns the cache off
+ *
+ * Return: None
+ */
+void PathCache::setCapacity(size_t bytes) {
+    lock_guard<mutex> guard(lock);
+    capacity = bytes;
+    evict();
+}
+
+/*
+ * Looks up the path of the pair, counting a hit or a miss
+ *
+ * Parameters:
+ *              firstId - the id of the first actor
+ *              secondId - the id of the second actor
+ *              weighted - true for a path over the movie weights
+ *              path - set to the cached path on a hit
+ *
+ * Return: true on a hit, false on a miss or if the cache is turned off
+ */
+bool PathCache::find(int firstId, int secondId, bool weighted,
+                     vector<int>& path) {
+    lock_guard<mutex> guard(lock);
+    if (capacity == 0) {
+        return false;
+    }
+    auto found = index.find(key(firstId, secondId, weighted));
+    if (found == index.end()) {
+        misses++;
+        return false;
+    }
+
+    // moves the entry to the front as the most recently used
+    entries.splice(entries.begin(), entries, found->second);
+    path = found->second->path;
+    hits++;
+    return true;
+}
+
+/*
+ * Caches the path of the pair as the most recently used
+ *
+ * Parameters:
+ *              firstId - the id of the first actor
+ *              secondId - the id of the second actor
+ *              weighted - true for a path over the movie weights
+ *              path - the path found, empty if the actors aren't connected
+ *
+ * Return: None
+ */
+void PathCache::insert(int firstId, int secondId, bool weighted,
+                       const vector<int>& path) {
+    lock_guard<mutex> guard(lock);
+    if (capacity == 0) {
+        return;
+    }
+    store(key(firstId, secondId, weighted), path);
+}
+
+/*
+ * Drops every path, for a graph that changed, keeping the counters
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void PathCache::clear() {
+    lock_guard<mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    usedBytes = 0;
+}
+
+/*
+ * Returns the number of paths cached
+ *
+ * Parameters: None
+ *
+ * Return: the number of paths
+ */
+size_t PathCache::size() const {
+    lock_guard<mutex> guard(lock);
+    return entries.size();
+}
+
+/*
+ * Returns roughly how many bytes the cached paths use
+ *
+ * Parameters: None
+ *
+ * Return: the bytes used
+ */
+size_t PathCache::bytes() const {
+    lock_guard<mutex> guard(lock);
+    return usedBytes;
+}
+
+/*
+ * Returns the number of lookups that found a path
+ *
+ * Parameters: None
+ *
+ * Return: the number of hits
+ */
+unsigned long long PathCache::getHits() const {
+    lock_guard<mutex> guard(lock);
+    return hits;
+}
+
+/*
+ * Returns the number of lookups that didn't find a path
+ *
+ * Parameters: None
+ *
+ * Return: the number of misses
+ */
+unsigned long long PathCache::getMisses() const {
+    lock_guard<mutex> guard(lock);
+    return misses;
+}
+
+/*
+ * Writes the cached paths to a file, most recently used first
+ *
+ * Parameters:
+ *              filename - the file to write
+ *              fingerprint - identifies the graph the paths belong to
+ *
+ * Return: true if the file was written, false otherwise
+ */
+bool PathCache::save(const char* filename,
+                     unsigned long long fingerprint) const {
+    lock_guard<mutex> guard(lock);
+    PathCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PATH_CACHE_MAGIC, PATH_CACHE_MAGIC_LENGTH);
+    header.version = PATH_CACHE_VERSION;
+    header.byteOrder = PATH_CACHE_BYTE_ORDER;
+    header.fingerprint = fingerprint;
+    header.numEntries = entries.size();
+
+    ofstream outFile(filename, ios::binary | ios::trunc);
+    if (!outFile) {
+        cerr << "Failed to write path cache " << filename << endl;
+        return false;
+    }
+    outFile.write((const char*)&header, sizeof(header));
+    for (const CacheEntry& entry : entries) {
+        unsigned int length = entry.path.size();
+        outFile.write((const char*)&entry.key, sizeof(entry.key));
+        outFile.write((const char*)&length, sizeof(length));
+        outFile.write((const char*)entry.path.data(), length * sizeof(int));
+    }
+    outFile.close();
+    if (!outFile) {
+        cerr << "Failed to write path cache " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Reads paths written by save, keeping their order of use and as many as fit
+ * under the cap. Paths saved for another graph are ignored, and so is a file
+ * whose entries claim more bytes than it has left.
+ *
+ * Parameters:
+ *              filename - the file to read
+ *              fingerprint - identifies the graph being searched
+ *
+ * Return: true if the file belonged to the graph and was read, false
+ * otherwise
+ */
+bool PathCache::load(const char* filename, unsigned long long fingerprint) {
+    ifstream inFile(filename, ios::binary | ios::ate);
+    if (!inFile) {
+        return false;
+    }
+    unsigned long long remaining = inFile.tellg();
+    inFile.seekg(0);
+    PathCacheHeader header;
+    if (!inFile.read((char*)&header, sizeof(header)) ||
+        memcmp(header.magic, PATH_CACHE_MAGIC, PATH_CACHE_MAGIC_LENGTH) != 0 ||
+        header.version != PATH_CACHE_VERSION ||
+        header.byteOrder != PATH_CACHE_BYTE_ORDER ||
+        header.fingerprint != fingerprint) {
+        return false;
+    }
+    remaining -= sizeof(header);
+
+    // reads every entry before caching any, so a truncated file adds nothing,
+    // and checks each length against the bytes left before allocating it so
+    // a damaged one can't ask for more memory than the file could fill
+    vector<CacheEntry> saved;
+    for (unsigned long long i = 0; i < header.numEntries; i++) {
+        CacheEntry entry;
+        unsigned int length;
+        if (!inFile.read((char*)&entry.key, sizeof(entry.key)) ||
+            !inFile.read((char*)&length, sizeof(length))) {
+            return false;
+        }
+        remaining -= sizeof(entry.key) + sizeof(length);
+        if (length > remaining / sizeof(int)) {
+            return false;
+        }
+        remaining -= length * sizeof(int);
+        entry.path.resize(length);
+        if (!inFile.read((char*)entry.path.data(), length * sizeof(int))) {
+            return false;
+        }
+        saved.push_back(move(entry));
+    }
+
+    // the least recently used go in first so the order of use is kept
+    lock_guard<mutex> guard(lock);
+    for (auto entry = saved.rbegin(); entry != saved.rend(); entry++) {
+        store(entry->key, entry->path);
+    }
+    return true;
+}
@@ -0,0 +1,143 @@
+/**
+ * PathCache.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: Remembers the paths found for pairs of actors, so a pair asked
+ * again within a run or across runs doesn't need another search. The least
+ * recently used paths are dropped once the cache outgrows its memory cap.
+ * Sources: Piazza
+ */
+#ifndef PATHCACHE_HPP
+#define PATHCACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The paths of pairs of actor ids, each laid out from the second actor back
+ * to the first, alternating between actor ids and movie ids. An empty path
+ * means the actors aren't connected. Every method may be called by several
+ * threads at once.
+ */
+class PathCache {
+  private:
+    // one cached path and the pair and mode it was found for
+    struct CacheEntry {
+        unsigned long long key;
+        vector<int> path;
+    };
+
+    list<CacheEntry> entries;  // the most recently used first
+    unordered_map<unsigned long long, list<CacheEntry>::iterator> index;
+    size_t capacity;   // the bytes the cache may use, 0 turns it off
+    size_t usedBytes;  // the bytes the entries use
+    unsigned long long hits;
+    unsigned long long misses;
+    mutable mutex lock;
+
+    /* Returns the key of the pair in the mode */
+    static unsigned long long key(int firstId, int secondId, bool weighted) {
+        return (unsigned long long)(unsigned int)firstId << 33 |
+               (unsigned long long)(unsigned int)secondId << 1 | weighted;
+    }
+
+    /* Returns roughly how many bytes an entry of the path takes up */
+    static size_t entryBytes(const vector<int>& path);
+
+    /* Drops the least recently used entries until the cap is met */
+    void evict();
+
+    /* Adds or refreshes the entry of the key, the lock must be held */
+    void store(unsigned long long entryKey, const vector<int>& path);
+
+  public:
+    /* Constructor that starts out turned off */
+    PathCache() : capacity(0), usedBytes(0), hits(0), misses(0) {}
+
+    /*
+     * Sets how many bytes the cache may use, dropping the least recently used
+     * paths that no longer fit
+     *
+     * Parameters:
+     *              bytes - the memory cap, 0 turns the cache off
+     *
+     * Return: None
+     */
+    void setCapacity(size_t bytes);
+
+    /*
+     * Looks up the path of the pair, counting a hit or a miss
+     *
+     * Parameters:
+     *              firstId - the id of the first actor
+     *              secondId - the id of the second actor
+     *              weighted - true for a path over the movie weights
+     *              path - set to the cached path on a hit
+     *
+     * Return: true on a hit, false on a miss or if the cache is turned off
+     */
+    bool find(int firstId, int secondId, bool weighted, vector<int>& path);
+
+    /*
+     * Caches the path of the pair as the most recently used
+     *
+     * Parameters:
+     *              firstId - the id of the first actor
+     *              secondId - the id of the second actor
+     *              weighted - true for a path over the movie weights
+     *              path - the path found, empty if the actors aren't connected
+     *
+     * Return: None
+     */
+    void insert(int firstId, int secondId, bool weighted,
+                const vector<int>& path);
+
+    /* Drops every path, for a graph that changed, keeping the counters */
+    void clear();
+
+    /* Returns the number of paths cached */
+    size_t size() const;
+
+    /* Returns roughly how many bytes the cached paths use */
+    size_t bytes() const;
+
+    /* Returns the number of lookups that found a path */
+    unsigned long long getHits() const;
+
+    /* Returns the number of lookups that didn't */
+    unsigned long long getMisses() const;
+
+    /*
+     * Writes the cached paths to a file, most recently used first
+     *
+     * Parameters:
+     *              filename - the file to write
+     *              fingerprint - identifies the graph the paths belong to
+     *
+     * Return: true if the file was written, false otherwise
+     */
+    bool save(const char* filename, unsigned long long fingerprint) const;
+
+    /*
+     * Reads paths written by save, keeping their order of use and as many
+     * as fit under the cap. Paths saved for another graph are ignored, and
+     * so is a file whose entries claim more bytes than it has left.
+     *
+     * Parameters:
+     *              filename - the file to read
+     *              fingerprint - identifies the graph being searched
+     *
+     * Return: true if the file belonged to the graph and was read, false
+     * otherwise
+     */
+    bool load(const char* filename, unsigned long long fingerprint);
+};
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * RadixHeap.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: A monotone priority queue for Dijkstra over the movie weights.
+ * Weights are small positive integers, so nothing is ever queued ahead of the
+ * actor last taken off, and an actor only moves between buckets when the
+ * lowest key passes its own. Queueing is a couple of bit operations instead
+ * of sifting a binary heap.
+ * Sources: Piazza
+ */
+#ifndef RADIXHEAP_HPP
+#define RADIXHEAP_HPP
+
+#include <vector>
+
+#define NUM_RADIX_BUCKETS 65
+
+using namespace std;
+
+/**
+ * An actor waiting in the Dijkstra queue with the distance it was queued at
+ */
+struct SearchEntry {
+    int dist;     // the distance the actor was reached with
+    int rank;     // the position of the actor's name in alphabetical order
+    int actorId;  // the actor reached
+};
+
+/**
+ * Actors waiting in order of distance, then of name. Bucket `b` holds the
+ * keys whose highest bit differing from the last key taken off is bit
+ * `b - 1`, bucket 0 the keys equal to it. Every key queued must be no lower
+ * than the last one taken off.
+ */
+class RadixHeap {
+  private:
+    vector<SearchEntry> buckets[NUM_RADIX_BUCKETS];
+    unsigned long long last;  // the key of the actor last taken off
+    size_t numEntries;        // the actors waiting in every bucket
+
+    /* Returns the key ordering the entry, lower in distance then in name */
+    static unsigned long long key(const SearchEntry& entry) {
+        return (unsigned long long)(unsigned int)entry.dist << 32 |
+               (unsigned int)entry.rank;
+    }
+
+    /* Returns the bucket the key belongs in given the last key taken off */
+    int bucket(unsigned long long entryKey) const {
+        return entryKey == last ? 0 : 64 - __builtin_clzll(entryKey ^ last);
+    }
+
+    /*
+     * Makes the lowest key the last one taken off, moving the entries of the
+     * first bucket that isn't empty down to bucket 0 and the buckets below
+     *
+     * Parameters: None
+     *
+     * Return: None
+     */
+    void settle() {
+        if (!buckets[0].empty()) {
+            return;
+        }
+        int first = 1;
+        while (buckets[first].empty()) {
+            first++;
+        }
+        vector<SearchEntry>& spill = buckets[first];
+        last = key(spill[0]);
+        for (const SearchEntry& entry : spill) {
+            if (key(entry) < last) {
+                last = key(entry);
+            }
+        }
+        for (const SearchEntry& entry : spill) {
+            buckets[bucket(key(entry))].push_back(entry);
+        }
+        spill.clear();
+    }
+
+  public:
+    /* Constructor that starts out empty */
+    RadixHeap() : last(0), numEntries(0) {}
+
+    /* Queues the entry, its key must be no lower than the last taken off */
+    void push(const SearchEntry& entry) {
+        buckets[bucket(key(entry))].push_back(entry);
+        numEntries++;
+    }
+
+    /* Returns the entry of the lowest key, the heap must not be empty */
+    const SearchEntry& top() {
+        settle();
+        return buckets[0].back();
+    }
+
+    /* Takes the entry of the lowest key off, the heap must not be empty */
+    SearchEntry pop() {
+        settle();
+        SearchEntry entry = buckets[0].back();
+        buckets[0].pop_back();
+        numEntries--;
+        return entry;
+    }
+
+    /* Tells if no actors are waiting */
+    bool empty() const { return numEntries == 0; }
+
+    /* Returns the number of actors waiting */
+    size_t size() const { return numEntries; }
+
+    /* Drops every entry, keeping the room of each bucket */
+    void clear() {
+        for (vector<SearchEntry>& entries : buckets) {
+            entries.clear();
+        }
+        last = 0;
+        numEntries = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * SearchContext.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: The state of one shortest path search kept apart from the
+ * graph, so the graph stays read-only while it is searched and every thread
+ * can search it at once with a context of its own. Each actor's entry is
+ * stamped with the search that wrote it, so starting the next search doesn't
+ * need to reset anything. A bidirectional search keeps a second side for the
+ * search from the other end.
+ * Sources: Piazza
+ */
+#ifndef SEARCHCONTEXT_HPP
+#define SEARCHCONTEXT_HPP
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "Bitmap.hpp"
+#include "RadixHeap.hpp"
+
+#define MULTI_SOURCE_WIDTH 64
+#define MULTI_SOURCE_UNREACHED 255
+
+using namespace std;
+
+/**
+ * The distance, previous actor and connecting movie of every actor reached by
+ * a search from one end, along with the queues it searches with. Nothing is
+ * freed between searches so a side used again doesn't allocate.
+ */
+class SearchSide {
+  private:
+    vector<unsigned int> reachedIn;  // the search that reached each actor
+    vector<unsigned int> doneIn;     // the search that finished each actor
+    vector<unsigned int> openedIn;   // the search that opened each movie
+    vector<int> distances;           // the distance to each actor
+    vector<int> previous;            // the actor each actor was reached from
+    vector<int> connectors;          // the movie that relates the two
+    unsigned int search;             // the stamp of the current search
+    bool tracking;                   // if prev and connector are kept
+
+  public:
+    vector<int> frontier;       // the actors waiting in the BFS queue
+    RadixHeap queue;            // the actors waiting in Dijkstra
+    Bitmap level;               // the level a bottom up BFS step expands
+    Bitmap visited;             // the actors reached, for bottom up steps
+
+    /* Constructor that starts out without room for any actors */
+    SearchSide() : search(0), tracking(true) {}
+
+    /*
+     * Starts a new search, making room for the graph's actors and movies
+     *
+     * Parameters:
+     *              numActors - the number of actors in the graph
+     *              numMovies - the number of movies in the graph
+     *
+     * Return: None
+     */
+    void begin(int numActors, int numMovies) {
+        if ((int)reachedIn.size() < numActors) {
+            reachedIn.resize(numActors, 0);
+            doneIn.resize(numActors, 0);
+            distances.resize(numActors);
+            previous.resize(numActors);
+            connectors.resize(numActors);
+        }
+        if ((int)openedIn.size() < numMovies) {
+            openedIn.resize(numMovies, 0);
+        }
+
+        // once the stamps wrap around the old ones can't be told apart
+        if (++search == 0) {
+            fill(reachedIn.begin(), reachedIn.end(), 0);
+            fill(doneIn.begin(), doneIn.end(), 0);
+            fill(openedIn.begin(), openedIn.end(), 0);
+            search = 1;
+        }
+        frontier.clear();
+        queue.clear();
+    }
+
+    /* Tells if the current search reached the actor */
+    bool reached(int actorId) const { return reachedIn[actorId] == search; }
+
+    /* Returns the distance to the actor, INT_MAX if it wasn't reached */
+    int dist(int actorId) const {
+        return reached(actorId) ? distances[actorId] : INT_MAX;
+    }
+
+    /* Returns the actor the actor was reached from, -1 for the start */
+    int prev(int actorId) const { return previous[actorId]; }
+
+    /* Returns the movie relating the actor to the one it was reached from */
+    int connector(int actorId) const { return connectors[actorId]; }
+
+    /*
+     * Records a shorter way to the actor
+     *
+     * Parameters:
+     *              actorId - the actor reached
+     *              distance - the distance to the actor
+     *              prevId - the actor it was reached from, -1 for the start
+     *              movieId - the movie relating the two, -1 for the start
+     *
+     * Return: None
+     */
+    void reach(int actorId, int distance, int prevId, int movieId) {
+        reachedIn[actorId] = search;
+        distances[actorId] = distance;
+        if (tracking) {
+            previous[actorId] = prevId;
+            connectors[actorId] = movieId;
+        }
+    }
+
+    /* Tells if prev and connector are kept for the actors reached */
+    bool tracks() const { return tracking; }
+
+    /* Turns keeping prev and connector on or off */
+    void track(bool on) { tracking = on; }
+
+    /* Tells if the actor's neighbors were already searched */
+    bool done(int actorId) const { return doneIn[actorId] == search; }
+
+    /* Marks the actor's neighbors as searched */
+    void finish(int actorId) { doneIn[actorId] = search; }
+
+    /* Marks the movie as opened, false if it already was */
+    bool open(int movieId) {
+        if (openedIn[movieId] == search) {
+            return false;
+        }
+        openedIn[movieId] = search;
+        return true;
+    }
+};
+
+/**
+ * The state of one search. The context itself is the side searching from the
+ * first actor, which is all a search in one direction uses.
+ */
+class SearchContext : public SearchSide {
+  public:
+    SearchSide backward;  // the side searching back from the second actor
+    int length;  // the length found by a search that doesn't track paths
+    int limit;   // the longest way a search looks for, INT_MAX for any
+
+    /* Constructor that starts out looking for a way of any length */
+    SearchContext() : length(0), limit(INT_MAX) {}
+
+    /*
+     * Turns keeping prev and connector on or off for both sides. A search
+     * that doesn't track them stops as soon as it knows the length of the
+     * shortest way and leaves it in length instead of laying out a path.
+     *
+     * Parameters:
+     *              on - keep prev and connector
+     *
+     * Return: None
+     */
+    void trackPaths(bool on) {
+        track(on);
+        backward.track(on);
+    }
+};
+
+/**
+ * The state of one bit-parallel BFS from up to MULTI_SOURCE_WIDTH actors at
+ * once. Bit i of each actor's words stands for the i-th source, so a whole
+ * level of every source's search is expanded with one pass over the edges.
+ */
+struct MultiSourceSearch {
+    vector<unsigned long long> seen;    // the sources that reached each actor
+    vector<unsigned long long> visit;   // the sources whose level has it
+    vector<unsigned long long> next;    // the sources reaching it next
+    vector<unsigned long long> movies;  // the sources reaching each cast next
+
+    // the hops from each source to every actor, one row of actors for each
+    // source, MULTI_SOURCE_UNREACHED where it doesn't reach
+    vector<unsigned char> distances;
+};
+
+/**
+ * An actor within the bound of a neighborhood, and the actor and movie it is
+ * reached through on a shortest path from the center
+ */
+struct NeighborhoodEntry {
+    int actorId;    // the id of the actor
+    int distance;   // the hops or total weight from the center
+    int previous;   // the actor before it, -1 for the center
+    int connector;  // the movie relating the two, -1 for the center
+};
+
+/**
+ * The distance from one actor to every actor, and if asked for, the actor
+ * and movie each one is reached through on a shortest path
+ */
+struct ActorDistances {
+    vector<int> distances;   // to each actor by id, -1 where not reached
+    vector<int> previous;    // the actor before each, -1 for the source
+    vector<int> connectors;  // the movie relating the two, -1 for the source
+};
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * StringInterner.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: Hands out contiguous integer ids for strings so the graph can
+ * index arrays by id and keep exactly one copy of every actor name and movie
+ * title. Names are only looked up again when the results are printed. The
+ * strings and the hash table are flat arrays of offsets, so the whole table
+ * can be written to a snapshot and used in place once mapped back in.
+ * Sources: Piazza
+ */
+#ifndef STRINGINTERNER_HPP
+#define STRINGINTERNER_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "FrozenArray.hpp"
+
+#define INTERNER_EMPTY_SLOT -1
+#define INTERNER_MIN_SLOTS 16
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+using namespace std;
+
+/**
+ * A table relating strings to the ids 0, 1, 2, ... in the order they were
+ * first interned. String `id` is chars[starts[id] .. starts[id + 1]).
+ */
+class StringInterner {
+  private:
+    FrozenArray<char> chars;           // every string back to back
+    FrozenArray<unsigned int> starts;  // where each string starts in chars
+    FrozenArray<int> slots;  // open addressing table of ids, a power of two
+
+    /*
+     * Probes the table for the string
+     *
+     * Parameters:
+     *              str - the first character of the string
+     *              length - the number of characters
+     *              hashValue - the hash of the string
+     *
+     * Return: the slot holding the string's id or the empty slot it belongs
+     * in, -1 if there is no table yet
+     */
+    long findSlot(const char* str, size_t length,
+                  unsigned int hashValue) const {
+        if (slots.empty()) {
+            return -1;
+        }
+        size_t mask = slots.size() - 1;
+        size_t slot = hashValue & mask;
+        while (slots[slot] != INTERNER_EMPTY_SLOT &&
+               !equals(slots[slot], str, length)) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    /* Tells if the string of the id is the given string */
+    bool equals(int id, const char* str, size_t length) const {
+        return this->length(id) == length &&
+               memcmp(data(id), str, length) == 0;
+    }
+
+    /*
+     * Doubles the table and puts every id back in
+     *
+     * Parameters:
+     *              minimumSlots - the table grows to at least this size
+     *
+     * Return: None
+     */
+    void grow(size_t minimumSlots) {
+        size_t numSlots = INTERNER_MIN_SLOTS;
+        while (numSlots < minimumSlots) {
+            numSlots *= 2;
+        }
+        vector<int> table(numSlots, INTERNER_EMPTY_SLOT);
+        for (int id = 0; id < size(); id++) {
+            size_t slot = hash(data(id), length(id)) & (numSlots - 1);
+            while (table[slot] != INTERNER_EMPTY_SLOT) {
+                slot = (slot + 1) & (numSlots - 1);
+            }
+            table[slot] = id;
+        }
+        slots.assign(move(table));
+    }
+
+  public:
+    /* FNV-1a, fixed so a saved table still works in the next run */
+    static unsigned int hash(const char* str, size_t length) {
+        unsigned int value = FNV_OFFSET_BASIS;
+        for (size_t i = 0; i < length; i++) {
+            value = (value ^ (unsigned char)str[i]) * FNV_PRIME;
+        }
+        return value;
+    }
+
+    /*
+     * Finds the id of the string, giving it the next id if it is new. Takes
+     * the hash from the caller so it can be worked out ahead of time, such
+     * as by the threads parsing the movie cast file.
+     *
+     * Parameters:
+     *              str - the first character of the string
+     *              length - the number of characters
+     *              hashValue - the hash of the string
+     *
+     * Return: the id of the string
+     */
+    int intern(const char* str, size_t length, unsigned int hashValue) {
+        // keeps the table at most half full
+        if (2 * ((size_t)size() + 1) > slots.size()) {
+            grow(4 * ((size_t)size() + 1));
+        }
+        size_t slot = findSlot(str, length, hashValue);
+        if (slots[slot] != INTERNER_EMPTY_SLOT) {
+            return slots[slot];
+        }
+
+        int id = size();
+        vector<char>& characters = chars.edit();
+        vector<unsigned int>& offsets = starts.edit();
+        if (offsets.empty()) {
+            offsets.push_back(0);
+        }
+        characters.insert(characters.end(), str, str + length);
+        offsets.push_back(characters.size());
+        slots.edit()[slot] = id;
+        return id;
+    }
+
+    /* Finds the id of the string, giving it the next id if it is new */
+    int intern(const char* str, size_t length) {
+        return intern(str, length, hash(str, length));
+    }
+
+    /* Finds the id of the string, giving it the next id if it is new */
+    int intern(const string& str) { return intern(str.data(), str.size()); }
+
+    /*
+     * Finds the id of the string without adding it
+     *
+     * Parameters:
+     *              str - the first character of the string
+     *              length - the number of characters
+     *
+     * Return: the id of the string, -1 if it was never interned
+     */
+    int find(const char* str, size_t length) const {
+        long slot = findSlot(str, length, hash(str, length));
+        return slot == -1 ? -1 : slots[slot];
+    }
+
+    /* Finds the id of the string without adding it, -1 if never interned */
+    int find(const string& str) const { return find(str.data(), str.size()); }
+
+    /* Returns a copy of the string of the id, used when printing */
+    string name(int id) const { return string(data(id), length(id)); }
+
+    /* Returns the first character of the string of the id */
+    const char* data(int id) const { return chars.data() + starts[id]; }
+
+    /* Returns the number of characters in the string of the id */
+    size_t length(int id) const { return starts[id + 1] - starts[id]; }
+
+    /* Tells if the string of lhs comes before the string of rhs */
+    bool less(int lhs, int rhs) const {
+        size_t lhsLength = length(lhs);
+        size_t rhsLength = length(rhs);
+        int compared = memcmp(data(lhs), data(rhs), min(lhsLength, rhsLength));
+        return compared != 0 ? compared < 0 : lhsLength < rhsLength;
+    }
+
+    /* Returns the number of strings interned so far */
+    int size() const { return starts.empty() ? 0 : (int)starts.size() - 1; }
+
+    /* Reserves room for the given number of strings */
+    void reserve(int count) {
+        if (2 * (size_t)count > slots.size()) {
+            grow(2 * (size_t)count);
+        }
+        starts.edit().reserve(count + 1);
+    }
+
+    /* Returns the characters of every string, for saving a snapshot */
+    const FrozenArray<char>& getChars() const { return chars; }
+
+    /* Returns where each string starts, for saving a snapshot */
+    const FrozenArray<unsigned int>& getStarts() const { return starts; }
+
+    /* Returns the hash table of ids, for saving a snapshot */
+    const FrozenArray<int>& getSlots() const { return slots; }
+
+    /*
+     * Uses the arrays of a mapped snapshot in place of building the table
+     *
+     * Parameters:
+     *              characters - every string back to back
+     *              numChars - the number of characters
+     *              offsets - where each string starts in characters
+     *              numOffsets - the number of strings plus one
+     *              table - the hash table of ids
+     *              numSlots - the size of the table, a power of two
+     *
+     * Return: None
+     */
+    void borrow(const char* characters, size_t numChars,
+                const unsigned int* offsets, size_t numOffsets,
+                const int* table, size_t numSlots) {
+        chars.borrow(characters, numChars);
+        starts.borrow(offsets, numOffsets);
+        slots.borrow(table, numSlots);
+    }
+};
+
+#endif
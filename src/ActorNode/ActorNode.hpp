@@ -5,7 +5,8 @@
  * Email: maskndaf@ucsd.edu
  *
  * Description: Each actor has a node that stores it's neighbors, connections,
- * properities when finding the shortest path and more.
+ * the position of its name and more. The state of a shortest path search is
+ * kept in a SearchContext so the nodes aren't written while searching.
  * Sources:Piazza
  */
 #ifndef ACTORNODE_HPP
@@ -23,29 +24,18 @@ using namespace std;
  */
 class ActorNode {
   public:
-    string nameOfActor;  // the name of the actor
-    int dist;            // the distance between the previous node and this
-    ActorNode* prev;     // the previous node in the sequence
-    bool done;           // checks if the node has had their neighbors searched
-    string nameOfConnector;  // the movie of that relates prev and this node
+    int id;        // the index of the actor, its name lives in the graph
+    int nameRank;  // the position of the actor's name in alphabetical order
     int priority;  // the priority of the node when finding shortest unweighted
 
-    // string is movie name, int is the year, vector is the connections
-    unordered_map<string, unordered_map<int, vector<ActorNode*>>> edges;
     unordered_map<ActorNode*, int>
         neighbors;  // int is the number of connections
     unordered_map<ActorNode*, int> neighborsWeighted;  // int is weight
-    unordered_map<ActorNode*, string> movieNeighborsWeighted;
+    unordered_map<ActorNode*, int> movieNeighborsWeighted;  // int is movie id
 
     /* Constructor that initialize a ActorNode */
-    ActorNode(string actorName, string movieName, int movieYear)
-        : nameOfActor(actorName),
-          dist(INT_MAX),
-          done(false),
-          prev(NULL),
-          priority(0) {
-        edges[movieName][movieYear].push_back(0);
-    }
+    explicit ActorNode(int actorId)
+        : id(actorId), nameRank(actorId), priority(0) {}
 };
 
 // for the priority queue in kruskal's algorithm
@@ -58,26 +48,7 @@ struct WeightedPairComparator {
         }
 
         // higher alphabetization goes higher in priority
-        if (rhs.first.first->nameOfActor.compare(
-                lhs.first.first->nameOfConnector) > 0) {
-            return false;
-        } else {
-            return true;
-        }
-    }
-};
-
-// lower in distance, goes higher in priority, so does lower in string
-struct WeightedComparator {
-    bool operator()(ActorNode*& lhs, ActorNode*& rhs) const {
-        if (lhs->dist != rhs->dist) {
-            return rhs->dist < lhs->dist;
-        }
-        if (rhs->nameOfActor.compare(lhs->nameOfActor) > 0) {
-            return false;
-        } else {
-            return true;
-        }
+        return rhs.first.first->nameRank < lhs.first.first->nameRank;
     }
 };
 
@@ -89,11 +60,7 @@ struct ActorNodePtrComp {
             return lhs->priority > rhs->priority;
         }
 
-        if (rhs->nameOfActor.compare(lhs->nameOfActor) > 0) {
-            return true;
-        } else {
-            return false;
-        }
+        return lhs->nameRank < rhs->nameRank;
     }
 };
 #endif
@@ -0,0 +1,214 @@
+/**
+ * GraphOptions.hpp
+ * Author: Michael Askndafi
+ * Date: 10/18/2026
+ * Email: maskndaf@ucsd.edu
+ *
+ * Description: The command line options shared by every executable that loads
+ * an ActorGraph, so pathfinder, linkpredictor and movietraveler read and build
+ * their graph the same way.
+ * Sources: Piazza
+ */
+#ifndef GRAPHOPTIONS_HPP
+#define GRAPHOPTIONS_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ActorGraph.hpp"
+#include "cxxopts.hpp"
+
+#define MOVIES_OPTION "movies"
+#define BIPARTITE_OPTION "bipartite"
+#define SAVE_SNAPSHOT_OPTION "save-snapshot"
+#define LOAD_SNAPSHOT_OPTION "load-snapshot"
+#define THREADS_OPTION "threads"
+#define LANDMARKS_OPTION "landmarks"
+#define HIERARCHY_OPTION "hierarchy"
+#define LABELS_OPTION "labels"
+
+using namespace std;
+
+/*
+ * Adds the options for loading and building the graph, including the
+ * positional movie cast file every executable starts with
+ *
+ * Parameters:
+ *              options - the options of the executable
+ *
+ * Return: None
+ */
+inline void addGraphOptions(cxxopts::Options& options) {
+    options.add_options()(MOVIES_OPTION, "the movie cast tsv file",
+                          cxxopts::value<string>());
+    options.add_options("graph")(
+        BIPARTITE_OPTION,
+        "keep movies as their own nodes instead of linking every pair of "
+        "actors in each movie")(
+        SAVE_SNAPSHOT_OPTION,
+        "write the built graph to a binary snapshot file",
+        cxxopts::value<string>(), "FILE")(
+        LOAD_SNAPSHOT_OPTION,
+        "map the graph from a snapshot file instead of reading the movie cast "
+        "file",
+        cxxopts::value<string>(), "FILE")(
+        THREADS_OPTION,
+        "the number of threads to load and search the graph with, 0 for one "
+        "per core",
+        cxxopts::value<unsigned int>()->default_value("0"), "N")(
+        LANDMARKS_OPTION,
+        "the number of landmark actors to guide weighted searches with, kept "
+        "in the snapshot, 0 for none",
+        cxxopts::value<unsigned int>(), "N")(
+        HIERARCHY_OPTION,
+        "answer weighted searches with a contraction hierarchy kept in the "
+        "snapshot, which may pick another of several equally light paths")(
+        LABELS_OPTION,
+        "answer unweighted searches with distance labels kept in the "
+        "snapshot, which may pick another of several equally short paths");
+}
+
+/*
+ * Parses the arguments, turning a parsing error into a failed result instead
+ * of an exception. A snapshot stands in for the movie cast file, so with
+ * --load-snapshot the movie file may be left out of the positional arguments.
+ * The executable may let others be left out too, and checks afterwards that
+ * the options it was given don't need them. The movie file is taken to be
+ * the one missing first.
+ *
+ * Parameters:
+ *              options - the options of the executable
+ *              positional - the names of the positional arguments in order
+ *              argc - the number of arguments there are
+ *              argv - the strings given from the user
+ *              result - set to the parsed arguments when successful
+ *              omittable - the positional arguments that may be left out, in
+ *                          the order they are taken to be missing
+ *
+ * Return: true if every positional argument was given once, the movie file
+ * only left out for a snapshot, the rest only if omittable, and nothing else
+ * was left over, false otherwise
+ */
+inline bool parseArguments(cxxopts::Options& options,
+                           const vector<string>& positional, int argc,
+                           char** argv,
+                           unique_ptr<cxxopts::ParseResult>& result,
+                           const vector<string>& omittable = {}) {
+    // the parser moves the arguments around, so each try gets its own copy
+    auto parse = [&](const vector<string>& names, int& numLeft) {
+        vector<char*> arguments(argv, argv + argc);
+        char** left = arguments.data();
+        numLeft = argc;
+        options.parse_positional(names);
+        try {
+            result.reset(
+                new cxxopts::ParseResult(options.parse(numLeft, left)));
+        } catch (const cxxopts::OptionException& exception) {
+            cerr << exception.what() << endl;
+            return false;
+        }
+        return true;
+    };
+    int numLeft;
+    if (!parse(positional, numLeft)) {
+        return false;
+    }
+
+    // each one left out makes the arguments after it land one name early,
+    // leaving the last one unset
+    vector<string> missing;
+    if (result->count(LOAD_SNAPSHOT_OPTION) && !positional.empty() &&
+        positional.front() == MOVIES_OPTION) {
+        missing.push_back(MOVIES_OPTION);
+    }
+    missing.insert(missing.end(), omittable.begin(), omittable.end());
+    vector<string> given = positional;
+    for (const string& name : missing) {
+        auto position = find(given.begin(), given.end(), name);
+        if (given.empty() || result->count(given.back()) != 0 ||
+            position == given.end()) {
+            break;
+        }
+        given.erase(position);
+        if (!parse(given, numLeft)) {
+            return false;
+        }
+    }
+
+    // the parser leaves the unused arguments behind the program name
+    if (numLeft != 1) {
+        return false;
+    }
+    for (const string& name : given) {
+        if (result->count(name) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Loads the movie cast file and builds the graph the way the options ask for,
+ * or maps a snapshot of a graph built before. The landmarks are built when
+ * asked for a number the graph doesn't already have, the contraction hierarchy
+ * and the distance labels when asked for and not already there, and the graph
+ * is saved to a snapshot afterwards if asked.
+ *
+ * Parameters:
+ *              graph - the graph to load into
+ *              result - the parsed arguments
+ *              usingMovieTraveler - to check for using movie traveler
+ *                                  executable
+ *
+ * Return: true if the graph was loaded successfully, false otherwise
+ */
+inline bool loadGraph(ActorGraph& graph, const cxxopts::ParseResult& result,
+                      bool usingMovieTraveler) {
+    graph.setNumThreads(result[THREADS_OPTION].as<unsigned int>());
+    if (result.count(LOAD_SNAPSHOT_OPTION)) {
+        // the snapshot keeps the representation it was saved with
+        string snapshotFile = result[LOAD_SNAPSHOT_OPTION].as<string>();
+        if (!graph.loadSnapshot(snapshotFile.c_str())) {
+            return false;
+        }
+    } else {
+        string moviesFile = result[MOVIES_OPTION].as<string>();
+        if (!graph.loadFromFile(moviesFile.c_str(), false)) {
+            return false;
+        }
+
+        if (result.count(BIPARTITE_OPTION)) {
+            graph.buildBipartiteGraph();
+        } else {
+            graph.buildGraph(usingMovieTraveler);
+        }
+    }
+
+    if (result.count(LANDMARKS_OPTION)) {
+        int numLandmarks = result[LANDMARKS_OPTION].as<unsigned int>();
+        if (numLandmarks != graph.getNumLandmarks()) {
+            graph.buildLandmarks(numLandmarks);
+        }
+    }
+
+    if (result.count(HIERARCHY_OPTION) && !graph.hasHierarchy()) {
+        graph.buildHierarchy();
+    }
+
+    // the searches still work without labels, only slower
+    if (result.count(LABELS_OPTION) && !graph.hasDistanceLabels() &&
+        !graph.buildDistanceLabels()) {
+        cerr << "Couldn't label the graph's distances, searching without "
+             << "labels" << endl;
+    }
+
+    if (result.count(SAVE_SNAPSHOT_OPTION)) {
+        string snapshotFile = result[SAVE_SNAPSHOT_OPTION].as<string>();
+        return graph.saveSnapshot(snapshotFile.c_str());
+    }
+    return true;
+}
+
+#endif
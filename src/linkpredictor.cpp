@@ -12,6 +12,7 @@
 #include <vector>
 #include "ActorGraph.cpp"
 #include "ActorNode.hpp"
+#include "GraphOptions.hpp"
 
 #define ACTOR_TO_MOVIE_TRANSITION "--"
 #define MOVIE_TO_ACTOR_TRANSITION "-->"
@@ -21,9 +22,9 @@
 #define ACTOR_RIGHT_BRACKET ')'
 #define DELIMITER_BETWEEN_M_AND_Y "#@"
 #define MAX_COLLAB_PREDS 4
-#define OUT_FILE_PAST_PREDICTIONS 3
-#define OUT_FILE_FUTURE_PREDICTIONS 4
-#define TEST_ACTORS_FILE 2
+#define OUT_FILE_PAST_PREDICTIONS "past"
+#define OUT_FILE_FUTURE_PREDICTIONS "future"
+#define TEST_ACTORS_FILE "actors"
 #define TAB_CHARACTER '\t'
 
 using namespace std;
@@ -111,9 +112,6 @@ void predictFromPast(const char* outFileName, ActorGraph* list,
     outFile.open(outFileName);
     outFile << header << endl;
 
-    // keeps track of the graph
-    unordered_map<string, ActorNode*> graph = list->getGraph();
-
     // all firstlevel neighbors of the node from hte listOfActors
     unordered_map<string, ActorNode*> firstLevelNeighbors;
 
@@ -123,21 +121,21 @@ void predictFromPast(const char* outFileName, ActorGraph* list,
     for (unsigned int ANodeIndex = 0; ANodeIndex < listOfActors.size();
          ANodeIndex++) {
         int currentLowestPriority = 0;
-        ActorNode* curr;
-        if (graph.find(listOfActors[ANodeIndex]) == graph.end()) {
+        int actorId = list->getActorId(listOfActors[ANodeIndex]);
+        if (actorId == -1) {
             break;
         }
-        curr =
-            graph[listOfActors[ANodeIndex]];  // current root from listOfActors
+        ActorNode* curr =
+            list->getNode(actorId);  // current root from listOfActors
 
-        auto ANeighbors = curr->neighbors;
+        auto ANeighbors = list->getNeighbors(curr);
 
         // searches every firstLevelNeighbor for connections with a neighbor
         for (auto ANodeIterator = ANeighbors.begin();
              ANodeIterator != ANeighbors.end(); ANodeIterator++) {
             ActorNode* BNode =
                 ANodeIterator->first;  // the node to find priority for
-            auto BNeighbors = BNode->neighbors;
+            auto BNeighbors = list->getNeighbors(BNode);
             BNode->priority = 0;
             for (auto CNodeIterator = ANeighbors.begin();
                  CNodeIterator != ANeighbors.end(); CNodeIterator++) {
@@ -170,7 +168,7 @@ void predictFromPast(const char* outFileName, ActorGraph* list,
 
         // gets values of pq in reverse order and prints out that way
         for (int i = pq.size() - 1; i >= 0; i--) {
-            top4.push_back(pq.top()->nameOfActor);
+            top4.push_back(list->getActorName(pq.top()->id));
             pq.pop();
         }
         for (int i = top4.size() - 1; i >= 0; i--) {
@@ -213,32 +211,35 @@ void predictNew(const char* outFileName, ActorGraph* list,
     outFile << header << endl;
 
     // same as predictPast
-    unordered_map<string, ActorNode*> graph = list->getGraph();
-    unordered_map<ActorNode*, vector<ActorNode*>> secondLevelNeighbors;
+    // the neighbors between the actor and each second-level neighbor with
+    // the number of movies the neighbor shares with the second-level neighbor
+    unordered_map<ActorNode*, vector<pair<ActorNode*, int>>>
+        secondLevelNeighbors;
     priority_queue<ActorNode*, vector<ActorNode*>, ActorNodePtrComp> pq;
 
     // goes through list of actors
     for (unsigned int ANodeIndex = 0; ANodeIndex < listOfActors.size();
          ANodeIndex++) {
         secondLevelNeighbors.clear();
-        ActorNode* curr;
-        if (graph.find(listOfActors[ANodeIndex]) == graph.end()) {
+        int actorId = list->getActorId(listOfActors[ANodeIndex]);
+        if (actorId == -1) {
             break;
         }
-        curr = graph[listOfActors[ANodeIndex]];
-        auto ANeighbors = curr->neighbors;
+        ActorNode* curr = list->getNode(actorId);
+        auto ANeighbors = list->getNeighbors(curr);
 
         // find the second-level neighbors
         for (auto ANodeIterator = ANeighbors.begin();
              ANodeIterator != ANeighbors.end(); ANodeIterator++) {
             auto BNode = ANodeIterator->first;
-            auto BNeighbors = BNode->neighbors;
+            auto BNeighbors = list->getNeighbors(BNode);
             for (auto BNodeIterator = BNeighbors.begin();
                  BNodeIterator != BNeighbors.end(); BNodeIterator++) {
                 ActorNode* CNeighbor = BNodeIterator->first;
                 if (curr == CNeighbor) continue;
                 if (ANeighbors.find(CNeighbor) == ANeighbors.end()) {
-                    secondLevelNeighbors[CNeighbor].push_back(BNode);
+                    secondLevelNeighbors[CNeighbor].push_back(
+                        make_pair(BNode, BNodeIterator->second));
                 }
             }
         }
@@ -254,7 +255,7 @@ void predictNew(const char* outFileName, ActorGraph* list,
             auto vectorsL2 = secondLevelIterator->second;
             for (auto element : vectorsL2) {
                 secondLevelNode->priority +=
-                    ANeighbors[element] * secondLevelNode->neighbors[element];
+                    ANeighbors[element.first] * element.second;
             }
 
             // puts in queue if priority too low or not enough in queue
@@ -279,7 +280,7 @@ void predictNew(const char* outFileName, ActorGraph* list,
 
         // prints out top 4 in reverse order
         for (int i = pq.size() - 1; i >= 0; i--) {
-            top4.push_back(pq.top()->nameOfActor);
+            top4.push_back(list->getActorName(pq.top()->id));
             pq.pop();
         }
         for (int i = top4.size() - 1; i >= 0; i--) {
@@ -306,20 +307,41 @@ void predictNew(const char* outFileName, ActorGraph* list,
  * Return: -1 failed, other is success
  */
 int main(int argc, char** argv) {
-    const int NUM_ARG = 5;
-    if (argc != NUM_ARG) {
+    cxxopts::Options options(argv[0],
+                             "Predicts the future collaborations of actors");
+    addGraphOptions(options);
+    options.add_options()(TEST_ACTORS_FILE, "the tsv file of actors",
+                          cxxopts::value<string>())(
+        OUT_FILE_PAST_PREDICTIONS,
+        "the file to print predictions among past collaborators",
+        cxxopts::value<string>())(
+        OUT_FILE_FUTURE_PREDICTIONS,
+        "the file to print predictions among new collaborators",
+        cxxopts::value<string>());
+
+    unique_ptr<cxxopts::ParseResult> result;
+    if (!parseArguments(options,
+                        {MOVIES_OPTION, TEST_ACTORS_FILE,
+                         OUT_FILE_PAST_PREDICTIONS,
+                         OUT_FILE_FUTURE_PREDICTIONS},
+                        argc, argv, result)) {
         return -1;
     }
     ActorGraph graph;
-    graph.loadFromFile(argv[1], false);
-    graph.buildGraph(false);
+    if (!loadGraph(graph, *result, false)) {
+        return -1;
+    }
 
     vector<string> listOfActors;
-    listOfActors = getListOfActors(argv[TEST_ACTORS_FILE]);
+    listOfActors =
+        getListOfActors((*result)[TEST_ACTORS_FILE].as<string>().c_str());
 
-    predictFromPast(argv[OUT_FILE_PAST_PREDICTIONS], &graph, listOfActors);
+    predictFromPast(
+        (*result)[OUT_FILE_PAST_PREDICTIONS].as<string>().c_str(), &graph,
+        listOfActors);
 
-    predictNew(argv[OUT_FILE_FUTURE_PREDICTIONS], &graph, listOfActors);
+    predictNew((*result)[OUT_FILE_FUTURE_PREDICTIONS].as<string>().c_str(),
+               &graph, listOfActors);
 
     return 0;
 }
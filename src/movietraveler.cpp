@@ -12,6 +12,7 @@
 #include <vector>
 #include "ActorGraph.cpp"
 #include "ActorNode.hpp"
+#include "GraphOptions.hpp"
 
 #define ACTOR_TO_MOVIE_TRANSITION "<--"
 #define MOVIE_TO_ACTOR_TRANSITION "-->"
@@ -20,7 +21,7 @@
 #define ACTOR_LEFT_BRACKET '('
 #define ACTOR_RIGHT_BRACKET ')'
 #define DELIMITER_BETWEEN_M_AND_Y "#@"
-#define OUTPUT_FILE_ARG 2
+#define OUTPUT_FILE_ARG "output"
 
 using namespace std;
 
@@ -35,33 +36,19 @@ string formatActor(string actorName) {
     return ACTOR_LEFT_BRACKET + actorName + ACTOR_RIGHT_BRACKET;
 }
 
-/*
- * For the proper format of movies and year, the method formally returns the
- * correct semantics of a movie and year
- *
- * Parameters:
- *              movie - the movie to be altered
- *              year - the year to be concatenated to the movie
- *
- * Return: the formal version of the movie and year
- */
-string formatMovieAndYear(string movie, int year) {
-    return MOVIE_LEFT_BRACKET + movie + DELIMITER_BETWEEN_M_AND_Y +
-           to_string(year) + MOVIE_RIGHT_BRACKET;
-}
-
 /*
  * Printing in the format actor--movie-->actor to the outFile that are the most
  * efficient.
  *
  * Parameters:
  *              outFile - the stream to print out the connections
+ *              graph - the graph to look up the names of actors and movies
  *              result - each connection from an actor
  *
  * Return: None
  */
 void printMovieTraveler(
-    ofstream& outFile,
+    ofstream& outFile, ActorGraph* graph,
     unordered_map<ActorNode*, vector<pair<ActorNode*, int>>>& result) {
     // the two actors in each connection
     ActorNode* firstNode;
@@ -82,20 +69,23 @@ void printMovieTraveler(
             secondNode = iterator->second.at(i).first;
             weight += iterator->second.at(i).second;
 
-            outFile << formatActor(firstNode->nameOfActor)
+            outFile << formatActor(graph->getActorName(firstNode->id))
                     << ACTOR_TO_MOVIE_TRANSITION;
 
             // finds the connector movie across each node cause the connection
             // isn't in both
             if (firstNode->movieNeighborsWeighted.find(secondNode) !=
                 firstNode->movieNeighborsWeighted.end()) {
-                outFile << firstNode->movieNeighborsWeighted[secondNode];
+                outFile << graph->formatMovie(
+                    firstNode->movieNeighborsWeighted[secondNode]);
             } else if (secondNode->movieNeighborsWeighted.find(firstNode) !=
                        secondNode->movieNeighborsWeighted.end()) {
-                outFile << secondNode->movieNeighborsWeighted[firstNode];
+                outFile << graph->formatMovie(
+                    secondNode->movieNeighborsWeighted[firstNode]);
             }
             outFile << MOVIE_TO_ACTOR_TRANSITION;
-            outFile << formatActor(secondNode->nameOfActor) << endl;
+            outFile << formatActor(graph->getActorName(secondNode->id))
+                    << endl;
         }
     }
 
@@ -125,7 +115,7 @@ void minimumSpanningTree(const char* outFileName, ActorGraph* graph) {
     outFile.open(outFileName);
     outFile << header << endl;
 
-    printMovieTraveler(outFile, result);
+    printMovieTraveler(outFile, graph, result);
 
     outFile.close();
 }
@@ -139,15 +129,24 @@ void minimumSpanningTree(const char* outFileName, ActorGraph* graph) {
  * Return: -1 if unsuccessful, otherwise successful
  */
 int main(int argc, char** argv) {
-    const int NUM_ARG = 3;
-    if (argc != NUM_ARG) {
+    cxxopts::Options options(
+        argv[0], "Prints the lightest tree of movies connecting every actor");
+    addGraphOptions(options);
+    options.add_options()(OUTPUT_FILE_ARG, "the file to print the tree to",
+                          cxxopts::value<string>());
+
+    unique_ptr<cxxopts::ParseResult> result;
+    if (!parseArguments(options, {MOVIES_OPTION, OUTPUT_FILE_ARG}, argc, argv,
+                        result)) {
         return -1;
     }
     ActorGraph graph;
-    graph.loadFromFile(argv[1], false);
-    graph.buildGraph(true);
+    if (!loadGraph(graph, *result, true)) {
+        return -1;
+    }
 
-    minimumSpanningTree(argv[OUTPUT_FILE_ARG], &graph);
+    minimumSpanningTree((*result)[OUTPUT_FILE_ARG].as<string>().c_str(),
+                        &graph);
 
     return 0;
 }
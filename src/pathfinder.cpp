@@ -6,13 +6,15 @@
  * output.
  * Sources: Piazza
  */
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <vector>
 #include "ActorGraph.cpp"
+#include "GraphOptions.hpp"
 
-#define INCREMENTOR 2
 #define UNWEIGHTED_CHAR 'u'
 #define WEIGHTED_CHAR 'w'
 #define ACTOR_TO_MOVIE_TRANSITION "--"
@@ -24,6 +26,20 @@
 #define DELIMITER_BETWEEN_M_AND_Y "#@"
 #define TWO_COLUMNS 2
 #define TAB_CHAR '\t'
+#define EDGE_TYPE_OPTION "edges"
+#define PAIRS_OPTION "pairs"
+#define OUTPUT_OPTION "output"
+#define CACHE_MB_OPTION "cache-mb"
+#define PERSIST_CACHE_OPTION "persist-cache"
+#define CACHE_STATS_OPTION "cache-stats"
+#define DISTANCES_FROM_OPTION "distances-from"
+#define DISTANCE_ONLY_OPTION "distance-only"
+#define PREVIOUS_OPTION "previous"
+#define BINARY_OPTION "binary"
+#define WITHIN_OPTION "within"
+#define COMPONENTS_OPTION "components"
+#define PATH_CACHE_SUFFIX ".paths"
+#define BYTES_PER_MB (1024 * 1024)
 
 using namespace std;
 
@@ -34,11 +50,11 @@ using namespace std;
  * Parameters:
  *              in_filename - the name of the file to read from
  *
- * Return: the vector of actors to eventually find colloborations for.
+ * Return: the pairs of actors to eventually find colloborations for.
  */
-vector<string> getTestPairs(const char* in_filename) {
+vector<pair<string, string>> getTestPairs(const char* in_filename) {
     ifstream infile(in_filename);
-    vector<string> test_pairs;
+    vector<pair<string, string>> test_pairs;
 
     bool have_header = false;
 
@@ -72,8 +88,7 @@ vector<string> getTestPairs(const char* in_filename) {
             continue;
         }
 
-        test_pairs.push_back(record.at(0));
-        test_pairs.push_back(record.at(1));
+        test_pairs.emplace_back(record.at(0), record.at(1));
     }
     infile.close();
     return test_pairs;
@@ -82,18 +97,25 @@ vector<string> getTestPairs(const char* in_filename) {
 /*
  * Formally write the way an actor should be written for the output file
  *
- * Parameters: actorName - the name of the actor to format
+ * Parameters: outFile - the stream to write the actor to
+ *             graph - the graph the actor's id is from
+ *             actorId - the id of the actor to write
  *
- * Return: the newly formatted string
+ * Return: None
  */
-string formatActor(string actorName) {
-    return ACTOR_LEFT_BRACKET + actorName + ACTOR_RIGHT_BRACKET;
+void writeActor(ostream& outFile, const ActorGraph* graph, int actorId) {
+    outFile << ACTOR_LEFT_BRACKET;
+    graph->writeActorName(outFile, actorId);
+    outFile << ACTOR_RIGHT_BRACKET;
 }
 
 /*
  * Description: Find the shortest paths, first checking if the must have
  * weighted or unweighted then relying on each pair to go through Dikjstra's
- * algorithm to find the shortest path.
+ * algorithm to find the shortest path. The pairs are searched on all of the
+ * graph's threads and printed in the order they were read. The searches
+ * only keep the ids along each path, and the names are written out once the
+ * paths are found.
  *
  * Parameters: outFileName - the name of the file to print the connections to
  *             test_pairs - the pairs of actors to find connections for
@@ -103,7 +125,8 @@ string formatActor(string actorName) {
  *
  * Return: None
  */
-void findShortestPaths(const char* outFileName, vector<string> test_pairs,
+void findShortestPaths(const char* outFileName,
+                       const vector<pair<string, string>>& test_pairs,
                        ActorGraph* graph, bool useWeighted) {
     // prints out the header
     string header = "(actor)--[movie#@year]-->(actor)--...";
@@ -112,34 +135,190 @@ void findShortestPaths(const char* outFileName, vector<string> test_pairs,
     outFile.open(outFileName);
     outFile << header << endl;
 
+    // the searches only give ids, the names are written straight from the
+    // graph once each path is done
+    vector<vector<int>> paths =
+        graph->shortestPathIds(test_pairs, useWeighted);
+
     // going through each pairing
-    for (unsigned int i = 0; i < test_pairs.size(); i += INCREMENTOR) {
-        vector<string> returnedPath;
+    for (const vector<int>& returnedPath : paths) {
         bool traversor = false;  // if false then print actor, else print movie
-        if (useWeighted) {
-            returnedPath = graph->shortestWeightedPath(test_pairs.at(i),
-                                                       test_pairs.at(i + 1));
-        } else {
-            returnedPath = graph->shortestUnweightedPath(test_pairs.at(i),
-                                                         test_pairs.at(i + 1));
-        }
 
-        // print the path by going through the vector of strings
+        // print the path by going through the vector of ids
         for (int j = returnedPath.size() - 1; j >= 1; j--) {
             if (traversor) {
-                outFile << returnedPath.at(j) << MOVIE_TO_ACTOR_TRANSITION;
+                graph->writeMovie(outFile, returnedPath.at(j));
+                outFile << MOVIE_TO_ACTOR_TRANSITION;
             } else {
-                outFile << formatActor(returnedPath.at(j))
-                        << ACTOR_TO_MOVIE_TRANSITION;
+                writeActor(outFile, graph, returnedPath.at(j));
+                outFile << ACTOR_TO_MOVIE_TRANSITION;
             }
             traversor = !traversor;  // alternate through movie and actor
         }
 
         // prints out actor at the end
         if (returnedPath.size() > 1) {
-            outFile << formatActor(returnedPath.at(0));
+            writeActor(outFile, graph, returnedPath.at(0));
+        }
+        outFile << '\n';
+    }
+    outFile.close();
+}
+
+/*
+ * Description: Writes the length of a shortest path between each pair, in
+ * the order they were read, without finding the paths themselves: the hops
+ * for unweighted edges and the total weight for weighted ones, -1 where the
+ * pair isn't connected.
+ *
+ * Parameters: outFileName - the name of the file to print the distances to
+ *             test_pairs - the pairs of actors to find distances for
+ *             graph - the pre-built graph to search through
+ *             useWeighted - for telling if should care about weights of edges
+ *
+ * Return: None
+ */
+void findDistances(const char* outFileName,
+                   const vector<pair<string, string>>& test_pairs,
+                   ActorGraph* graph, bool useWeighted) {
+    vector<int> distances = graph->shortestDistances(test_pairs, useWeighted);
+
+    ofstream outFile(outFileName);
+    outFile << "Actor1" << TAB_CHAR << "Actor2" << TAB_CHAR << "Distance"
+            << endl;
+    for (unsigned int i = 0; i < test_pairs.size(); i++) {
+        outFile << test_pairs[i].first << TAB_CHAR << test_pairs[i].second
+                << TAB_CHAR << distances[i] << '\n';
+    }
+    outFile.close();
+}
+
+/*
+ * Description: Writes the distance from the actor to every actor it reaches,
+ * the hops for unweighted edges and the total weight for weighted ones, all
+ * found in one traversal over the whole graph on all of its threads. The
+ * TSV has one actor per line in the order the actors were read, with the
+ * actor and movie before it on a shortest path if asked for. The binary
+ * file holds 32-bit ints in the machine's byte order: the number of actors,
+ * then the distance to every actor by id, -1 where it isn't reached, then
+ * if asked for the id of the actor and of the movie before each, -1 for the
+ * source and the actors not reached. Given a bound, only the actors within
+ * it are searched, one search on one thread that stops at the bound, and
+ * the rest are left out as if not reached.
+ *
+ * Parameters: outFileName - the name of the file to print the distances to
+ *             actorName - the actor to find the distances from
+ *             graph - the pre-built graph to search through
+ *             useWeighted - for telling if should care about weights of edges
+ *             withPrevious - also print the actor and movie before each
+ *             binary - print the binary arrays instead of the TSV
+ *             bound - the most hops or total weight to search out to, -1
+ *                     for the whole graph
+ *
+ * Return: true if the actor exists, false otherwise
+ */
+bool findDistancesFrom(const char* outFileName, const string& actorName,
+                       ActorGraph* graph, bool useWeighted, bool withPrevious,
+                       bool binary, int bound) {
+    ActorDistances result;
+    if (bound == -1) {
+        if (!graph->allDistances(actorName, useWeighted, withPrevious,
+                                 result)) {
+            cerr << "No actor named " << actorName << endl;
+            return false;
+        }
+    } else {
+        vector<NeighborhoodEntry> entries =
+            graph->neighborhood(actorName, bound, useWeighted);
+        if (entries.empty()) {
+            cerr << "No actor named " << actorName << endl;
+            return false;
+        }
+        int numActors = graph->getNumActors();
+        result.distances.assign(numActors, -1);
+        if (withPrevious) {
+            result.previous.assign(numActors, -1);
+            result.connectors.assign(numActors, -1);
+        }
+        for (const NeighborhoodEntry& entry : entries) {
+            result.distances[entry.actorId] = entry.distance;
+            if (withPrevious) {
+                result.previous[entry.actorId] = entry.previous;
+                result.connectors[entry.actorId] = entry.connector;
+            }
+        }
+    }
+    const vector<int>& distances = result.distances;
+
+    if (binary) {
+        ofstream outFile(outFileName, ios::binary);
+        int numActors = distances.size();
+        outFile.write((const char*)&numActors, sizeof(int));
+        outFile.write((const char*)distances.data(), numActors * sizeof(int));
+        if (withPrevious) {
+            outFile.write((const char*)result.previous.data(),
+                          numActors * sizeof(int));
+            outFile.write((const char*)result.connectors.data(),
+                          numActors * sizeof(int));
+        }
+        outFile.close();
+        return true;
+    }
+
+    ofstream outFile(outFileName);
+    outFile << "Actor1" << TAB_CHAR << "Actor2" << TAB_CHAR << "Distance";
+    if (withPrevious) {
+        outFile << TAB_CHAR << "Previous" << TAB_CHAR << "Movie";
+    }
+    outFile << endl;
+    for (unsigned int actorId = 0; actorId < distances.size(); actorId++) {
+        if (distances[actorId] == -1) {
+            continue;
         }
-        outFile << endl;
+        outFile << actorName << TAB_CHAR;
+        graph->writeActorName(outFile, actorId);
+        outFile << TAB_CHAR << distances[actorId];
+        if (withPrevious) {
+            outFile << TAB_CHAR;
+            if (result.previous[actorId] != -1) {
+                graph->writeActorName(outFile, result.previous[actorId]);
+                outFile << TAB_CHAR;
+                graph->writeMovie(outFile, result.connectors[actorId]);
+            } else {
+                outFile << TAB_CHAR;
+            }
+        }
+        outFile << '\n';
+    }
+    outFile.close();
+    return true;
+}
+
+/*
+ * Description: Writes how many connected components of each size the graph
+ * has, largest first, one size per line after the total number of actors
+ * and components.
+ *
+ * Parameters: outFileName - the name of the file to print the report to
+ *             graph - the pre-built graph to report on
+ *
+ * Return: None
+ */
+void writeComponents(const char* outFileName, const ActorGraph* graph) {
+    vector<int> sizes = graph->componentSizes();
+    sort(sizes.begin(), sizes.end(), greater<int>());
+
+    ofstream outFile(outFileName);
+    outFile << "Actors" << TAB_CHAR << graph->getNumActors() << '\n'
+            << "Components" << TAB_CHAR << sizes.size() << '\n'
+            << "Size" << TAB_CHAR << "Count" << endl;
+    for (unsigned int i = 0; i < sizes.size();) {
+        unsigned int next = i;
+        while (next < sizes.size() && sizes[next] == sizes[i]) {
+            next++;
+        }
+        outFile << sizes[i] << TAB_CHAR << next - i << '\n';
+        i = next;
     }
     outFile.close();
 }
@@ -153,29 +332,138 @@ void findShortestPaths(const char* outFileName, vector<string> test_pairs,
  * Return: -1 if unsuccessful, 0 if successful
  */
 int main(int argc, char** argv) {
-    const int NUM_ARG = 5;
-    if (argc != NUM_ARG) {
+    cxxopts::Options options(argv[0],
+                             "Finds the shortest path between pairs of actors");
+    addGraphOptions(options);
+    options.add_options()(EDGE_TYPE_OPTION,
+                          "u for unweighted or w for weighted edges",
+                          cxxopts::value<string>())(
+        PAIRS_OPTION,
+        "the tsv file of actor pairs, left out with --" COMPONENTS_OPTION
+        " or --" DISTANCES_FROM_OPTION,
+        cxxopts::value<string>())(
+        OUTPUT_OPTION, "the file to print the paths to",
+        cxxopts::value<string>())(
+        DISTANCES_FROM_OPTION,
+        "print the distance from the actor to every actor it reaches instead "
+        "of the paths of the pairs",
+        cxxopts::value<string>(), "ACTOR")(
+        PREVIOUS_OPTION,
+        "with --" DISTANCES_FROM_OPTION ", also print the actor and movie "
+        "before each actor on a shortest path")(
+        BINARY_OPTION,
+        "with --" DISTANCES_FROM_OPTION ", print 32-bit ints by actor id "
+        "instead of a tsv")(
+        WITHIN_OPTION,
+        "with --" DISTANCES_FROM_OPTION ", only search out to the given hops "
+        "or total weight",
+        cxxopts::value<unsigned int>(), "N")(
+        DISTANCE_ONLY_OPTION,
+        "print the length of each pair's shortest path instead of the path, "
+        "-1 where there is none")(
+        COMPONENTS_OPTION,
+        "print how many connected components of each size the graph has "
+        "instead of the paths of the pairs");
+    options.add_options("cache")(
+        CACHE_MB_OPTION,
+        "the megabytes the cache of paths already found may use, 0 turns it "
+        "off",
+        cxxopts::value<unsigned int>()->default_value("64"), "MB")(
+        PERSIST_CACHE_OPTION,
+        "keep the cached paths in a file next to the graph snapshot between "
+        "runs")(CACHE_STATS_OPTION, "print the cache hits and misses");
+
+    unique_ptr<cxxopts::ParseResult> result;
+    if (!parseArguments(options,
+                        {MOVIES_OPTION, EDGE_TYPE_OPTION, PAIRS_OPTION,
+                         OUTPUT_OPTION},
+                        argc, argv, result, {PAIRS_OPTION})) {
         return -1;
     }
 
-    // loads the movie file to create graph
-    ActorGraph graph;
-    graph.loadFromFile(argv[1], false);
+    // only the paths and distances of the pairs need the pairs file
+    if (!result->count(PAIRS_OPTION) && !result->count(COMPONENTS_OPTION) &&
+        !result->count(DISTANCES_FROM_OPTION)) {
+        cerr << "the pairs file may only be left out with --"
+             << COMPONENTS_OPTION << " or --" << DISTANCES_FROM_OPTION << endl;
+        return -1;
+    }
 
     bool isWeighted;
 
     // checks for types of edges there are
-    if (*argv[2] == UNWEIGHTED_CHAR) {
+    string edgeType = (*result)[EDGE_TYPE_OPTION].as<string>();
+    if (edgeType[0] == UNWEIGHTED_CHAR) {
         isWeighted = false;
-    } else if (*argv[2] == WEIGHTED_CHAR) {
+    } else if (edgeType[0] == WEIGHTED_CHAR) {
         isWeighted = true;
+    } else {
+        return -1;
+    }
+
+    // loads the movie file to create graph
+    ActorGraph graph;
+    if (!loadGraph(graph, *result, false)) {
+        return -1;
+    }
+
+    if (result->count(COMPONENTS_OPTION)) {
+        writeComponents((*result)[OUTPUT_OPTION].as<string>().c_str(), &graph);
+        return 0;
+    }
+    if (result->count(DISTANCES_FROM_OPTION)) {
+        int bound = result->count(WITHIN_OPTION)
+                        ? (*result)[WITHIN_OPTION].as<unsigned int>()
+                        : -1;
+        bool found = findDistancesFrom(
+            (*result)[OUTPUT_OPTION].as<string>().c_str(),
+            (*result)[DISTANCES_FROM_OPTION].as<string>(), &graph, isWeighted,
+            result->count(PREVIOUS_OPTION), result->count(BINARY_OPTION),
+            bound);
+        return found ? 0 : -1;
+    }
+    if (result->count(DISTANCE_ONLY_OPTION)) {
+        findDistances(
+            (*result)[OUTPUT_OPTION].as<string>().c_str(),
+            getTestPairs((*result)[PAIRS_OPTION].as<string>().c_str()), &graph,
+            isWeighted);
+        return 0;
+    }
+
+    // the cached paths live next to the snapshot the graph came from, a
+    // cache turned off leaves the file alone
+    size_t cacheMB = (*result)[CACHE_MB_OPTION].as<unsigned int>();
+    graph.setPathCacheCapacity(cacheMB * BYTES_PER_MB);
+    string cacheFile;
+    if (result->count(PERSIST_CACHE_OPTION) && cacheMB > 0) {
+        if (result->count(LOAD_SNAPSHOT_OPTION)) {
+            cacheFile = (*result)[LOAD_SNAPSHOT_OPTION].as<string>();
+        } else if (result->count(SAVE_SNAPSHOT_OPTION)) {
+            cacheFile = (*result)[SAVE_SNAPSHOT_OPTION].as<string>();
+        } else {
+            cerr << "--" << PERSIST_CACHE_OPTION << " needs a snapshot"
+                 << endl;
+            return -1;
+        }
+        cacheFile += PATH_CACHE_SUFFIX;
+        graph.loadPathCache(cacheFile.c_str());
     }
-    graph.buildGraph(false);
 
     // loads the pairings of the actors
-    vector<string> test_pairs;
-    test_pairs = getTestPairs(argv[3]);
+    vector<pair<string, string>> test_pairs;
+    test_pairs = getTestPairs((*result)[PAIRS_OPTION].as<string>().c_str());
 
-    findShortestPaths(argv[4], test_pairs, &graph, isWeighted);
+    findShortestPaths((*result)[OUTPUT_OPTION].as<string>().c_str(),
+                      test_pairs, &graph, isWeighted);
+
+    if (result->count(CACHE_STATS_OPTION)) {
+        const PathCache& cache = graph.getPathCache();
+        cout << "Path cache hits: " << cache.getHits()
+             << ", misses: " << cache.getMisses() << ", paths: " << cache.size()
+             << endl;
+    }
+    if (!cacheFile.empty() && !graph.savePathCache(cacheFile.c_str())) {
+        return -1;
+    }
     return 0;  // successful
 }
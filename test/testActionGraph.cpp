@@ -7,19 +7,1345 @@
  * Sources:Piazza
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include "ActorGraph.hpp"
 #include "ActorNode.hpp"
+#include "RadixHeap.hpp"
 
 using namespace std;
 using namespace testing;
 
+#define SAMPLE_FILE "testActionGraph_sample.tsv"
+#define SNAPSHOT_FILE "testActionGraph_sample.snapshot"
+
+/*
+ * Writes a small cast list to the sample file so each test can load a graph.
+ * Kevin Bacon and James McAvoy share two movies, Tom Holland is only linked
+ * through Robert Downey Jr. and Rose Byrne is a loner.
+ *
+ * Parameters: None
+ *
+ * Return: None
+ */
+void writeSampleFile() {
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n"
+           << "Kevin Bacon\tX-Men: First Class\t2011\n"
+           << "James McAvoy\tX-Men: First Class\t2011\n"
+           << "Kevin Bacon\tSplit\t2016\n"
+           << "James McAvoy\tSplit\t2016\n"
+           << "James McAvoy\tGlass\t2019\n"
+           << "Robert Downey Jr.\tGlass\t2019\n"
+           << "Robert Downey Jr.\tSpider-Man: Homecoming\t2017\n"
+           << "Tom Holland\tSpider-Man: Homecoming\t2017\n"
+           << "Rose Byrne\tNeighbors\t2014\n";
+}
+
 TEST(SimpleTest, TEST_EMPTY_GRAPH) {
     ActorGraph* graph = new ActorGraph();
     ASSERT_FALSE(graph->checkIfActorExists("Kevin Bacon"));
     delete graph;
 }
+
+TEST(SimpleTest, TEST_CSR_ADJACENCY) {
+    writeSampleFile();
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    graph.buildGraph(false);
+    remove(SAMPLE_FILE);
+
+    const CSRAdjacency& adjacency = graph.getAdjacency();
+    ASSERT_EQ(adjacency.numActors(), 5);
+
+    // Kevin Bacon reaches James McAvoy through both movies
+    int kevin = graph.getActorId("Kevin Bacon");
+    ASSERT_EQ(adjacency.degree(kevin), 2);
+    ASSERT_EQ(adjacency.weights[adjacency.begin(kevin)], 9);
+    ASSERT_EQ(adjacency.weights[adjacency.begin(kevin) + 1], 4);
+    ASSERT_EQ(adjacency.degree(graph.getActorId("Rose Byrne")), 0);
+
+    vector<string> path =
+        graph.shortestUnweightedPath("Kevin Bacon", "Tom Holland");
+    ASSERT_EQ(path.size(), 7);
+    ASSERT_EQ(path.front(), "Tom Holland");
+    ASSERT_EQ(path.back(), "Kevin Bacon");
+    ASSERT_TRUE(graph.shortestUnweightedPath("Kevin Bacon", "Rose Byrne")
+                    .empty());
+}
+
+TEST(SimpleTest, TEST_INTERNED_IDS) {
+    writeSampleFile();
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    graph.buildGraph(false);
+    remove(SAMPLE_FILE);
+
+    // ids are handed out in the order the actors and movies are first read
+    ASSERT_EQ(graph.getNumActors(), 5);
+    ASSERT_EQ(graph.getNumMovies(), 5);
+    ASSERT_EQ(graph.getActorId("Kevin Bacon"), 0);
+    ASSERT_EQ(graph.getActorId("Rose Byrne"), 4);
+    ASSERT_EQ(graph.getActorId("Katherine Waterston"), -1);
+    ASSERT_EQ(graph.getActorName(3), "Tom Holland");
+    ASSERT_EQ(graph.formatMovie(1), "[Split#@2016]");
+
+    // ranks follow the alphabetical order of the names
+    ASSERT_EQ(graph.getNode(graph.getActorId("James McAvoy"))->nameRank, 0);
+    ASSERT_EQ(graph.getNode(graph.getActorId("Tom Holland"))->nameRank, 4);
+}
+
+TEST(SimpleTest, TEST_BIPARTITE_MATCHES_CLIQUE) {
+    writeSampleFile();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(true);
+    bipartite.buildBipartiteGraph();
+    ASSERT_TRUE(bipartite.isBipartite());
+
+    ASSERT_EQ(bipartite.shortestUnweightedPath("Kevin Bacon", "Tom Holland"),
+              clique.shortestUnweightedPath("Kevin Bacon", "Tom Holland"));
+    ASSERT_EQ(bipartite.shortestWeightedPath("Tom Holland", "Kevin Bacon"),
+              clique.shortestWeightedPath("Tom Holland", "Kevin Bacon"));
+
+    // the two actors share both Split and X-Men: First Class
+    ActorNode* kevin = bipartite.getNode(bipartite.getActorId("Kevin Bacon"));
+    ActorNode* james = bipartite.getNode(bipartite.getActorId("James McAvoy"));
+    ASSERT_EQ(bipartite.getNeighbors(kevin)[james], 2);
+
+    // both trees link the four connected actors with the same total weight
+    unordered_map<ActorNode*, vector<pair<ActorNode*, int>>> cliqueTree;
+    unordered_map<ActorNode*, vector<pair<ActorNode*, int>>> bipartiteTree;
+    clique.minimumSpanningKruskal(cliqueTree);
+    bipartite.minimumSpanningKruskal(bipartiteTree);
+    int cliqueWeight = 0;
+    int bipartiteWeight = 0;
+    for (auto element : cliqueTree) {
+        for (auto edge : element.second) cliqueWeight += edge.second;
+    }
+    for (auto element : bipartiteTree) {
+        for (auto edge : element.second) bipartiteWeight += edge.second;
+    }
+    ASSERT_EQ(bipartiteWeight, cliqueWeight);
+    ASSERT_EQ(bipartiteWeight, 4 + 1 + 3);
+}
+
+TEST(SimpleTest, TEST_SNAPSHOT_ROUND_TRIP) {
+    writeSampleFile();
+    ActorGraph built;
+    ASSERT_TRUE(built.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    built.buildGraph(false);
+    ASSERT_TRUE(built.saveSnapshot(SNAPSHOT_FILE));
+
+    ActorGraph mapped;
+    ASSERT_TRUE(mapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    ASSERT_FALSE(mapped.isBipartite());
+    ASSERT_EQ(mapped.getNumActors(), built.getNumActors());
+    ASSERT_EQ(mapped.getNumMovies(), built.getNumMovies());
+    ASSERT_EQ(mapped.getActorId("Rose Byrne"), built.getActorId("Rose Byrne"));
+    ASSERT_EQ(mapped.getActorId("Nobody"), -1);
+    ASSERT_EQ(mapped.formatMovie(1), "[Split#@2016]");
+    ASSERT_EQ(mapped.shortestUnweightedPath("Kevin Bacon", "Tom Holland"),
+              built.shortestUnweightedPath("Kevin Bacon", "Tom Holland"));
+    ASSERT_EQ(mapped.shortestWeightedPath("Tom Holland", "Kevin Bacon"),
+              built.shortestWeightedPath("Tom Holland", "Kevin Bacon"));
+
+    // the neighbor maps are not saved, so they are counted through the movies
+    ActorNode* kevin = mapped.getNode(mapped.getActorId("Kevin Bacon"));
+    ActorNode* james = mapped.getNode(mapped.getActorId("James McAvoy"));
+    ASSERT_EQ(mapped.getNeighbors(kevin)[james], 2);
+
+    // a file that isn't a snapshot is refused
+    writeSampleFile();
+    ASSERT_FALSE(mapped.loadSnapshot(SAMPLE_FILE));
+    remove(SAMPLE_FILE);
+}
+
+TEST(SimpleTest, TEST_LOADER_SKIPS_MALFORMED_ROWS) {
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\r\n"
+           << "Kevin Bacon\tSplit\t2016\r\n"
+           << "\n"
+           << "Only Two\tColumns\n"
+           << "Too\tMany\tColumns\there\n"
+           << "No Year\tSplit\tunknown\n"
+           << "James McAvoy\tSplit\t2016";
+    sample.close();
+
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    graph.buildGraph(false);
+
+    // the carriage return stays out of the year and the last line counts
+    ASSERT_EQ(graph.getNumActors(), 2);
+    ASSERT_EQ(graph.getNumMovies(), 1);
+    ASSERT_EQ(graph.formatMovie(0), "[Split#@2016]");
+    ASSERT_FALSE(graph.checkIfActorExists("No Year"));
+    ASSERT_FALSE(graph.loadFromFile(SAMPLE_FILE, false));
+}
+
+TEST(SimpleTest, TEST_MOVIES_AFTER_CURRENT_YEAR) {
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n"
+           << "A\tM1\t2018\n"
+           << "B\tM1\t2018\n"
+           << "B\tM2\t2020\n"
+           << "C\tM2\t2020\n";
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    // the later movies are kept and weigh as much as one from 2019, the
+    // paths listed from the second actor back
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        ASSERT_EQ(graph->getNumMovies(), 2);
+        ASSERT_EQ(graph->shortestUnweightedPath("A", "C"),
+                  vector<string>({"C", "[M2#@2020]", "B", "[M1#@2018]", "A"}));
+        ASSERT_EQ(graph->shortestWeightedPath("A", "C"),
+                  vector<string>({"C", "[M2#@2020]", "B", "[M1#@2018]", "A"}));
+        graph->ingest({{"C", "M3", 2031}, {"D", "M3", 2031}});
+        ASSERT_EQ(graph->shortestUnweightedPath("A", "D").size(), 7u);
+        ASSERT_EQ(graph->shortestDistances({{"A", "D"}}, true)[0], 4);
+    }
+}
+
+TEST(SimpleTest, TEST_PARALLEL_LOAD_MATCHES_SERIAL) {
+    // enough rows for the file to be split between every thread
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 3000; row++) {
+        sample << "Actor " << row * 7 % 1000 << "\tMovie " << row % 400
+               << "\t" << 1990 + row % 3 << "\n";
+    }
+    sample.close();
+
+    ActorGraph serial;
+    ActorGraph parallel;
+    parallel.setNumThreads(4);
+    ASSERT_TRUE(serial.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(parallel.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    serial.buildGraph(false);
+    parallel.buildGraph(false);
+
+    // the ids are handed out in the same order, so the graphs are the same
+    ASSERT_EQ(parallel.getNumActors(), serial.getNumActors());
+    ASSERT_EQ(parallel.getNumMovies(), serial.getNumMovies());
+    for (int actorId = 0; actorId < serial.getNumActors(); actorId++) {
+        ASSERT_EQ(parallel.getActorName(actorId), serial.getActorName(actorId));
+    }
+    for (int movieId = 0; movieId < serial.getNumMovies(); movieId++) {
+        ASSERT_EQ(parallel.formatMovie(movieId), serial.formatMovie(movieId));
+    }
+    const CSRAdjacency& serialEdges = serial.getAdjacency();
+    const CSRAdjacency& parallelEdges = parallel.getAdjacency();
+    ASSERT_EQ(vector<int>(parallelEdges.neighbors.begin(),
+                          parallelEdges.neighbors.end()),
+              vector<int>(serialEdges.neighbors.begin(),
+                          serialEdges.neighbors.end()));
+}
+
+TEST(SimpleTest, TEST_PARALLEL_BUILD_MATCHES_SERIAL) {
+    // some actors are listed twice in the same movie
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 2000; row++) {
+        sample << "Actor " << row * 13 % 300 << "\tMovie " << row % 150
+               << "\t" << 1980 + row % 7 << "\n";
+    }
+    sample.close();
+
+    ActorGraph serial;
+    ActorGraph parallel;
+    parallel.setNumThreads(4);
+    ASSERT_TRUE(serial.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(parallel.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    serial.buildGraph(true);
+    parallel.buildGraph(true);
+
+    const CSRAdjacency& serialEdges = serial.getAdjacency();
+    const CSRAdjacency& parallelEdges = parallel.getAdjacency();
+    ASSERT_EQ(vector<int>(parallelEdges.offsets.begin(),
+                          parallelEdges.offsets.end()),
+              vector<int>(serialEdges.offsets.begin(),
+                          serialEdges.offsets.end()));
+    ASSERT_EQ(vector<int>(parallelEdges.movieIds.begin(),
+                          parallelEdges.movieIds.end()),
+              vector<int>(serialEdges.movieIds.begin(),
+                          serialEdges.movieIds.end()));
+
+    // every node has the same neighbors, counts and lightest movies
+    for (int actorId = 0; actorId < serial.getNumActors(); actorId++) {
+        ActorNode* serialNode = serial.getNode(actorId);
+        ActorNode* parallelNode = parallel.getNode(actorId);
+        ASSERT_EQ(parallelNode->neighbors.size(),
+                  serialNode->neighbors.size());
+        for (auto neighbor : serialNode->neighbors) {
+            ActorNode* other = parallel.getNode(neighbor.first->id);
+            ASSERT_EQ(parallelNode->neighbors[other], neighbor.second);
+        }
+        ASSERT_EQ(parallelNode->neighborsWeighted.size(),
+                  serialNode->neighborsWeighted.size());
+        for (auto neighbor : serialNode->neighborsWeighted) {
+            ActorNode* other = parallel.getNode(neighbor.first->id);
+            ASSERT_EQ(parallelNode->neighborsWeighted[other], neighbor.second);
+            ASSERT_EQ(parallelNode->movieNeighborsWeighted[other],
+                      serialNode->movieNeighborsWeighted[neighbor.first]);
+        }
+    }
+}
+
+TEST(SimpleTest, TEST_INGEST_MATCHES_FULL_LOAD) {
+    vector<ActorMovieRow> rows = {
+        {"Zendaya", "Spider-Man: Homecoming", 2017},
+        {"Rose Byrne", "Spider-Man: Homecoming", 2017},
+        {"Zendaya", "Dune", 2018},
+        {"Kevin Bacon", "Dune", 2018}};
+
+    writeSampleFile();
+    ofstream sample(SAMPLE_FILE, ios::app);
+    for (const ActorMovieRow& row : rows) {
+        sample << row.actor << "\t" << row.movieTitle << "\t" << row.year
+               << "\n";
+    }
+    sample.close();
+    ActorGraph full;
+    ASSERT_TRUE(full.loadFromFile(SAMPLE_FILE, false));
+    full.buildGraph(true);
+
+    writeSampleFile();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(true);
+    bipartite.buildBipartiteGraph();
+    clique.ingest(rows);
+    bipartite.ingest(rows);
+
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        ASSERT_EQ(graph->getNumActors(), full.getNumActors());
+        ASSERT_EQ(graph->getNumMovies(), full.getNumMovies());
+        ASSERT_EQ(graph->shortestUnweightedPath("Tom Holland", "Rose Byrne"),
+                  full.shortestUnweightedPath("Tom Holland", "Rose Byrne"));
+        ASSERT_EQ(graph->shortestWeightedPath("Rose Byrne", "James McAvoy"),
+                  full.shortestWeightedPath("Rose Byrne", "James McAvoy"));
+
+        // the new actor is ranked between the names around it
+        int zendaya = graph->getActorId("Zendaya");
+        ASSERT_EQ(graph->getNode(zendaya)->nameRank,
+                  full.getNode(full.getActorId("Zendaya"))->nameRank);
+        ActorNode* kevin = graph->getNode(graph->getActorId("Kevin Bacon"));
+        ASSERT_EQ(graph->getNeighbors(kevin)[graph->getNode(zendaya)], 1);
+
+        unordered_map<ActorNode*, vector<pair<ActorNode*, int>>> tree;
+        graph->minimumSpanningKruskal(tree);
+        int weight = 0;
+        for (auto element : tree) {
+            for (auto edge : element.second) weight += edge.second;
+        }
+        ASSERT_EQ(weight, 1 + 2 + 3 + 3 + 3);
+    }
+
+    // the grown rows are packed into a snapshot that can grow again
+    ASSERT_TRUE(clique.saveSnapshot(SNAPSHOT_FILE));
+    ActorGraph mapped;
+    ASSERT_TRUE(mapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    mapped.ingest({{"Rose Byrne", "Dune", 2018}});
+    ASSERT_EQ(mapped.shortestUnweightedPath("Rose Byrne", "Kevin Bacon").size(),
+              3u);
+}
+
+TEST(SimpleTest, TEST_CONCURRENT_SEARCHES) {
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << row * 7 % 200 << "\tMovie " << row % 120
+               << "\t" << 1990 + row % 11 << "\n";
+    }
+    sample.close();
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    graph.buildGraph(true);
+
+    // one context reused for every pair gives the same paths as fresh ones
+    vector<vector<string>> expected;
+    SearchContext reused;
+    for (int pair = 0; pair < 100; pair++) {
+        string first = "Actor " + to_string(pair);
+        string second = "Actor " + to_string(199 - pair);
+        SearchContext fresh;
+        expected.push_back(graph.shortestWeightedPath(first, second, fresh));
+        ASSERT_EQ(graph.shortestWeightedPath(first, second, reused),
+                  expected.back());
+        expected.push_back(graph.shortestUnweightedPath(first, second, fresh));
+        ASSERT_EQ(graph.shortestUnweightedPath(first, second, reused),
+                  expected.back());
+    }
+
+    // every thread searches the same const graph with a context of its own
+    const ActorGraph& shared = graph;
+    vector<vector<vector<string>>> found(4);
+    vector<thread> threads;
+    for (int worker = 0; worker < 4; worker++) {
+        threads.emplace_back([&shared, &found, worker]() {
+            SearchContext context;
+            for (int pair = 0; pair < 100; pair++) {
+                string first = "Actor " + to_string(pair);
+                string second = "Actor " + to_string(199 - pair);
+                found[worker].push_back(
+                    shared.shortestWeightedPath(first, second, context));
+                found[worker].push_back(
+                    shared.shortestUnweightedPath(first, second));
+            }
+        });
+    }
+    for (thread& worker : threads) {
+        worker.join();
+    }
+    for (int worker = 0; worker < 4; worker++) {
+        ASSERT_EQ(found[worker], expected);
+    }
+}
+
+TEST(SimpleTest, TEST_BATCH_PATHS_IN_ORDER) {
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << row * 7 % 200 << "\tMovie " << row % 120
+               << "\t" << 1990 + row % 11 << "\n";
+    }
+    sample.close();
+    ActorGraph graph;
+    graph.setNumThreads(4);
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    graph.buildGraph(false);
+
+    // more pairs than one block so every thread gets some, plus unknowns
+    vector<pair<string, string>> pairs;
+    for (int pair = 0; pair < 500; pair++) {
+        pairs.emplace_back("Actor " + to_string(pair % 200),
+                           "Actor " + to_string(pair * 31 % 210));
+    }
+    for (bool useWeighted : {false, true}) {
+        vector<vector<string>> paths = graph.shortestPaths(pairs, useWeighted);
+        ASSERT_EQ(paths.size(), pairs.size());
+        for (unsigned int i = 0; i < pairs.size(); i++) {
+            ASSERT_EQ(paths[i], useWeighted
+                                    ? graph.shortestWeightedPath(
+                                          pairs[i].first, pairs[i].second)
+                                    : graph.shortestUnweightedPath(
+                                          pairs[i].first, pairs[i].second));
+        }
+    }
+    ASSERT_TRUE(graph.shortestPaths({}, true).empty());
+}
+
+TEST(SimpleTest, TEST_PAIRS_GROUPED_BY_FIRST_ACTOR) {
+    // ties in both the hops and the weights, and a group of its own
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << (row * 7 + row / 120) % 200 << "\tMovie "
+               << row % 120 << "\t" << 1990 + row % 120 % 11 << "\n";
+    }
+    sample << "Loner\tSolo Movie\t2000\n";
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    // each first actor is searched once for all of its second actors, a
+    // repeated and an unreachable one among them, with the first actors
+    // interleaved so the groups are put back in the order of the pairs
+    vector<pair<string, string>> pairs;
+    for (int target = 0; target < 12; target++) {
+        for (int start : {3, 150, 77}) {
+            pairs.emplace_back("Actor " + to_string(start),
+                               "Actor " + to_string((start + target * 37) %
+                                                    200));
+        }
+    }
+    pairs.emplace_back("Actor 3", "Actor 40");
+    pairs.emplace_back("Actor 3", "Loner");
+    pairs.emplace_back("Actor 150", "Loner");
+    pairs.emplace_back("Actor 3", "Actor 40");
+
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        // each pair on its own is searched again rather than cached
+        graph->setPathCacheCapacity(0);
+        graph->setNumThreads(2);
+        for (bool useWeighted : {false, true}) {
+            vector<vector<string>> paths =
+                graph->shortestPaths(pairs, useWeighted);
+            ASSERT_EQ(paths.size(), pairs.size());
+            for (unsigned int i = 0; i < pairs.size(); i++) {
+                ASSERT_EQ(paths[i],
+                          useWeighted ? graph->shortestWeightedPath(
+                                            pairs[i].first, pairs[i].second)
+                                      : graph->shortestUnweightedPath(
+                                            pairs[i].first, pairs[i].second));
+            }
+            ASSERT_FALSE(paths[pairs.size() - 1].empty());
+            ASSERT_EQ(paths[pairs.size() - 1], paths[pairs.size() - 4]);
+            ASSERT_TRUE(paths[pairs.size() - 2].empty());
+            ASSERT_TRUE(paths[pairs.size() - 3].empty());
+        }
+    }
+}
+
+TEST(SimpleTest, TEST_BIDIRECTIONAL_BFS_TIES) {
+    // Bart and Cleo both link Abe to Dora, the one way BFS reaches Bart first
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n"
+           << "Abe\tFirst\t2000\n"
+           << "Bart\tFirst\t2000\n"
+           << "Cleo\tFirst\t2000\n"
+           << "Cleo\tSecond\t2001\n"
+           << "Dora\tSecond\t2001\n"
+           << "Bart\tThird\t2002\n"
+           << "Dora\tThird\t2002\n"
+           << "Dora\tFourth\t2003\n"
+           << "Eve\tFourth\t2003\n"
+           << "Finn\tFifth\t2004\n";
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        vector<string> path = graph->shortestUnweightedPath("Abe", "Eve");
+        ASSERT_EQ(path, vector<string>({"Eve", "[Fourth#@2003]", "Dora",
+                                        "[Third#@2002]", "Bart",
+                                        "[First#@2000]", "Abe"}));
+        path = graph->shortestUnweightedPath("Eve", "Abe");
+        ASSERT_EQ(path, vector<string>({"Abe", "[First#@2000]", "Cleo",
+                                        "[Second#@2001]", "Dora",
+                                        "[Fourth#@2003]", "Eve"}));
+        ASSERT_TRUE(graph->shortestUnweightedPath("Abe", "Finn").empty());
+    }
+}
+
+TEST(SimpleTest, TEST_BIDIRECTIONAL_DIJKSTRA_TIES) {
+    // Bart and Cleo link Abe to Dora equally well, the one way Dijkstra
+    // settles Bart first since his name comes first
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n"
+           << "Abe\tFirst\t2000\n"
+           << "Cleo\tFirst\t2000\n"
+           << "Bart\tFirst\t2000\n"
+           << "Cleo\tSecond\t2010\n"
+           << "Dora\tSecond\t2010\n"
+           << "Bart\tThird\t2010\n"
+           << "Dora\tThird\t2010\n"
+           << "Dora\tFourth\t2015\n"
+           << "Eve\tFourth\t2015\n"
+           << "Abe\tShortcut\t1950\n"
+           << "Eve\tShortcut\t1950\n";
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    // the one hop shortcut weighs more than the three hops around it
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        ASSERT_EQ(graph->shortestWeightedPath("Abe", "Eve"),
+                  vector<string>({"Eve", "[Fourth#@2015]", "Dora",
+                                  "[Third#@2010]", "Bart", "[First#@2000]",
+                                  "Abe"}));
+        ASSERT_EQ(graph->shortestWeightedPath("Eve", "Abe"),
+                  vector<string>({"Abe", "[First#@2000]", "Bart",
+                                  "[Third#@2010]", "Dora", "[Fourth#@2015]",
+                                  "Eve"}));
+        ASSERT_EQ(graph->shortestWeightedPath("Cleo", "Bart").size(), 3u);
+    }
+}
+
+TEST(SimpleTest, TEST_RADIX_HEAP_ORDER) {
+    // queues like Dijkstra does, never below the last entry taken off
+    RadixHeap heap;
+    vector<pair<int, int>> popped;
+    heap.push({0, 7, 0});
+    int next = 1;
+    while (!heap.empty()) {
+        SearchEntry entry = heap.pop();
+        popped.emplace_back(entry.dist, entry.rank);
+        for (int weight = 1; weight <= 3 && next < 300; weight++, next++) {
+            heap.push({entry.dist + (next * 7 % 40) + weight, next % 50, next});
+        }
+    }
+    ASSERT_EQ(popped.size(), 300u);
+    ASSERT_TRUE(is_sorted(popped.begin(), popped.end()));
+
+    // ties in distance come off in order of name
+    heap.clear();
+    heap.push({5, 3, 0});
+    heap.push({5, 1, 1});
+    heap.push({4, 9, 2});
+    ASSERT_EQ(heap.size(), 3u);
+    ASSERT_EQ(heap.top().actorId, 2);
+    heap.pop();
+    ASSERT_EQ(heap.pop().actorId, 1);
+    ASSERT_EQ(heap.pop().actorId, 0);
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(SimpleTest, TEST_PATH_CACHE) {
+    writeSampleFile();
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    graph.buildGraph(false);
+    graph.setPathCacheCapacity(1 << 20);
+    const PathCache& cache = graph.getPathCache();
+
+    // the second ask of each pair and mode is a hit with the same path, the
+    // other mode is cached apart since it takes another movie
+    vector<string> path =
+        graph.shortestWeightedPath("Tom Holland", "Kevin Bacon");
+    ASSERT_EQ(graph.shortestWeightedPath("Tom Holland", "Kevin Bacon"), path);
+    ASSERT_NE(graph.shortestUnweightedPath("Tom Holland", "Kevin Bacon"),
+              path);
+    ASSERT_TRUE(graph.shortestUnweightedPath("Rose Byrne", "Tom Holland")
+                    .empty());
+    ASSERT_TRUE(graph.shortestUnweightedPath("Rose Byrne", "Tom Holland")
+                    .empty());
+    ASSERT_EQ(cache.getHits(), 2u);
+    ASSERT_EQ(cache.getMisses(), 3u);
+    ASSERT_EQ(graph.shortestPaths({{"Tom Holland", "Kevin Bacon"},
+                                   {"Kevin Bacon", "Tom Holland"}},
+                                  true)[0],
+              path);
+    ASSERT_EQ(cache.getHits(), 3u);
+    ASSERT_EQ(cache.size(), 4u);
+
+    // the paths come back in a later run over the same graph only
+    ASSERT_TRUE(graph.savePathCache(SNAPSHOT_FILE));
+    ActorGraph later;
+    writeSampleFile();
+    ASSERT_TRUE(later.loadFromFile(SAMPLE_FILE, false));
+    later.buildBipartiteGraph();
+    later.setPathCacheCapacity(1 << 20);
+    ASSERT_TRUE(later.loadPathCache(SNAPSHOT_FILE));
+    ASSERT_EQ(later.getPathCache().size(), 4u);
+    ASSERT_EQ(later.shortestWeightedPath("Tom Holland", "Kevin Bacon"), path);
+    ASSERT_EQ(later.getPathCache().getHits(), 1u);
+
+    // a graph as big but with one movie from another year isn't the same
+    ofstream moved(SAMPLE_FILE);
+    moved << "Actor/Actress\tMovie\tYear\n"
+          << "Kevin Bacon\tX-Men: First Class\t2011\n"
+          << "James McAvoy\tX-Men: First Class\t2011\n"
+          << "Kevin Bacon\tSplit\t2016\n"
+          << "James McAvoy\tSplit\t2016\n"
+          << "James McAvoy\tGlass\t2019\n"
+          << "Robert Downey Jr.\tGlass\t2019\n"
+          << "Robert Downey Jr.\tSpider-Man: Homecoming\t2017\n"
+          << "Tom Holland\tSpider-Man: Homecoming\t2017\n"
+          << "Rose Byrne\tNeighbors\t2015\n";
+    moved.close();
+    ActorGraph other;
+    ASSERT_TRUE(other.loadFromFile(SAMPLE_FILE, false));
+    other.buildBipartiteGraph();
+    other.setPathCacheCapacity(1 << 20);
+    ASSERT_EQ(other.getNumMovies(), later.getNumMovies());
+    ASSERT_FALSE(other.loadPathCache(SNAPSHOT_FILE));
+    ASSERT_EQ(other.getPathCache().size(), 0u);
+
+    later.ingest({{"Zendaya", "Dune", 2018}});
+    ASSERT_EQ(later.getPathCache().size(), 0u);
+    ASSERT_FALSE(later.loadPathCache(SNAPSHOT_FILE));
+
+    // a path longer than the rest of the file is taken for damage, the
+    // length of the first one following the 32 byte header and its key
+    fstream damaged(SNAPSHOT_FILE, ios::in | ios::out | ios::binary);
+    damaged.seekp(40);
+    unsigned int length = 0xffffffffu;
+    damaged.write((const char*)&length, sizeof(length));
+    damaged.close();
+    ASSERT_FALSE(graph.loadPathCache(SNAPSHOT_FILE));
+    ASSERT_EQ(cache.size(), 4u);
+    remove(SNAPSHOT_FILE);
+    remove(SAMPLE_FILE);
+
+    // a small cap keeps only the most recently used paths
+    size_t cap = cache.bytes() / 2;
+    graph.setPathCacheCapacity(cap);
+    ASSERT_LT(cache.size(), 4u);
+    ASSERT_LE(cache.bytes(), cap);
+    unsigned long long hits = cache.getHits();
+    graph.shortestWeightedPath("Kevin Bacon", "Tom Holland");
+    ASSERT_EQ(cache.getHits(), hits + 1);
+}
+
+TEST(SimpleTest, TEST_LANDMARK_SEARCH) {
+    // two groups of actors with no movie in common, ties in weight in both
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << row * 7 % 200 << "\tMovie " << row % 120
+               << "\t" << 1990 + row % 11 << "\n";
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    // the landmarks only narrow the search, every path stays the same
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        vector<vector<string>> expected;
+        for (int pair = 0; pair < 100; pair++) {
+            expected.push_back(graph->shortestWeightedPath(
+                "Actor " + to_string(pair), "Actor " + to_string(199 - pair)));
+        }
+        graph->buildLandmarks(3);
+        ASSERT_EQ(graph->getNumLandmarks(), 3);
+        for (int pair = 0; pair < 100; pair++) {
+            ASSERT_EQ(graph->shortestWeightedPath(
+                          "Actor " + to_string(pair),
+                          "Actor " + to_string(199 - pair)),
+                      expected[pair]);
+        }
+        ASSERT_TRUE(graph->shortestWeightedPath("Actor 3", "Other 3").empty());
+    }
+
+    // the landmarks are saved with the graph and dropped once it changes
+    ASSERT_TRUE(clique.saveSnapshot(SNAPSHOT_FILE));
+    ActorGraph mapped;
+    ASSERT_TRUE(mapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    ASSERT_EQ(mapped.getNumLandmarks(), 3);
+    ASSERT_EQ(mapped.shortestWeightedPath("Actor 5", "Actor 150"),
+              clique.shortestWeightedPath("Actor 5", "Actor 150"));
+    clique.ingest({{"Actor 5", "Movie 0", 1990}});
+    ASSERT_EQ(clique.getNumLandmarks(), 0);
+}
+
+TEST(SimpleTest, TEST_HIERARCHY_MATCHES_DIJKSTRA) {
+    // two groups of actors with no movie in common, ties in weight in both
+    ofstream sample(SAMPLE_FILE);
+    set<pair<string, string>> roles;
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        string actor = "Actor " + to_string((row * 7 + row / 120) % 200);
+        string movie = "Movie " + to_string(row % 120);
+        int year = 1990 + row % 120 % 11;
+        sample << actor << "\t" << movie << "\t" << year << "\n";
+        roles.insert({actor, "[" + movie + "#@" + to_string(year) + "]"});
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    graph.buildBipartiteGraph();
+
+    // the weight of a path, -1 if an actor wasn't in the movie next to them
+    auto weigh = [&](const vector<string>& path) {
+        int weight = 0;
+        for (unsigned int i = 1; i + 1 < path.size(); i += 2) {
+            if (!roles.count({path[i - 1], path[i]}) ||
+                !roles.count({path[i + 1], path[i]})) {
+                return -1;
+            }
+            weight += 1 + 2019 - stoi(path[i].substr(path[i].find("#@") + 2));
+        }
+        return weight;
+    };
+    vector<int> expected;
+    for (int pair = 0; pair < 100; pair++) {
+        expected.push_back(weigh(graph.shortestWeightedPath(
+            "Actor " + to_string(pair), "Actor " + to_string(199 - pair))));
+    }
+
+    // the hierarchy may pick another path of several, but never a heavier one
+    graph.buildHierarchy();
+    ASSERT_TRUE(graph.hasHierarchy());
+    for (int pair = 0; pair < 100; pair++) {
+        vector<string> path = graph.shortestWeightedPath(
+            "Actor " + to_string(pair), "Actor " + to_string(199 - pair));
+        ASSERT_EQ(path.front(), "Actor " + to_string(199 - pair));
+        ASSERT_EQ(path.back(), "Actor " + to_string(pair));
+        ASSERT_EQ(weigh(path), expected[pair]);
+    }
+    ASSERT_TRUE(graph.shortestWeightedPath("Actor 3", "Other 3").empty());
+
+    // the hierarchy is saved with the graph and dropped once it changes
+    ASSERT_TRUE(graph.saveSnapshot(SNAPSHOT_FILE));
+    ActorGraph mapped;
+    ASSERT_TRUE(mapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    ASSERT_TRUE(mapped.hasHierarchy());
+    ASSERT_EQ(mapped.shortestWeightedPath("Actor 5", "Actor 150"),
+              graph.shortestWeightedPath("Actor 5", "Actor 150"));
+    graph.ingest({{"Actor 5", "Movie 0", 1990}});
+    ASSERT_FALSE(graph.hasHierarchy());
+}
+
+TEST(SimpleTest, TEST_LABELS_MATCH_BFS) {
+    // two groups of actors with no movie in common, ties in hops in both
+    ofstream sample(SAMPLE_FILE);
+    set<pair<string, string>> roles;
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        string actor = "Actor " + to_string((row * 7 + row / 120) % 200);
+        string movie = "Movie " + to_string(row % 120);
+        int year = 1990 + row % 120 % 11;
+        sample << actor << "\t" << movie << "\t" << year << "\n";
+        roles.insert({actor, "[" + movie + "#@" + to_string(year) + "]"});
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+    bipartite.setNumThreads(3);
+
+    // the hops of a path, -1 if an actor wasn't in the movie next to them
+    auto hops = [&](const vector<string>& path) {
+        for (unsigned int i = 1; i + 1 < path.size(); i += 2) {
+            if (!roles.count({path[i - 1], path[i]}) ||
+                !roles.count({path[i + 1], path[i]})) {
+                return -1;
+            }
+        }
+        return (int)path.size() / 2;
+    };
+
+    // the labels may pick another path of several, but never a longer one
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        vector<int> expected;
+        for (int pair = 0; pair < 100; pair++) {
+            string first = "Actor " + to_string(pair);
+            string second = "Actor " + to_string(199 - pair);
+            expected.push_back(graph->unweightedDistance(first, second));
+            ASSERT_EQ(hops(graph->shortestUnweightedPath(first, second)),
+                      expected[pair]);
+        }
+        ASSERT_TRUE(graph->buildDistanceLabels());
+        ASSERT_TRUE(graph->hasDistanceLabels());
+        for (int pair = 0; pair < 100; pair++) {
+            string first = "Actor " + to_string(pair);
+            string second = "Actor " + to_string(199 - pair);
+            vector<string> path = graph->shortestUnweightedPath(first, second);
+            ASSERT_EQ(path.front(), second);
+            ASSERT_EQ(path.back(), first);
+            ASSERT_EQ(hops(path), expected[pair]);
+            ASSERT_EQ(graph->unweightedDistance(first, second),
+                      expected[pair]);
+        }
+        ASSERT_EQ(graph->unweightedDistance("Actor 3", "Other 3"), -1);
+        ASSERT_EQ(graph->unweightedDistance("Actor 3", "Actor 3"), 0);
+        ASSERT_TRUE(graph->shortestUnweightedPath("Actor 3", "Other 3")
+                        .empty());
+    }
+
+    // the labels are saved with the graph and dropped once it changes
+    ASSERT_TRUE(bipartite.saveSnapshot(SNAPSHOT_FILE));
+    ActorGraph mapped;
+    ASSERT_TRUE(mapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    ASSERT_TRUE(mapped.hasDistanceLabels());
+    ASSERT_EQ(mapped.shortestUnweightedPath("Actor 5", "Actor 150"),
+              bipartite.shortestUnweightedPath("Actor 5", "Actor 150"));
+    bipartite.ingest({{"Actor 5", "Movie 0", 1990}});
+    ASSERT_FALSE(bipartite.hasDistanceLabels());
+}
+
+TEST(SimpleTest, TEST_DIRECTION_OPTIMIZING_DISTANCES) {
+    // two groups of actors with no movie in common, the levels soon cover
+    // most of the first group so the search goes bottom up
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << (row * 7 + row / 120) % 200 << "\tMovie "
+               << row % 120 << "\t" << 1990 + row % 120 % 11 << "\n";
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    // every distance is as long as the path a one way BFS finds
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        for (int source = 0; source < 200; source += 37) {
+            string first = "Actor " + to_string(source);
+            vector<int> distances = graph->unweightedDistances(first);
+            ASSERT_EQ((int)distances.size(), graph->getNumActors());
+            ASSERT_EQ(distances[graph->getActorId(first)], 0);
+            for (int actorId = 0; actorId < graph->getNumActors(); actorId++) {
+                string second = graph->getActorName(actorId);
+                if (second == first) {
+                    continue;
+                }
+                vector<string> path =
+                    graph->shortestUnweightedPath(first, second);
+                ASSERT_EQ(distances[actorId],
+                          path.empty() ? -1 : (int)path.size() / 2);
+            }
+        }
+        ASSERT_TRUE(graph->unweightedDistances("Nobody").empty());
+    }
+}
+
+TEST(SimpleTest, TEST_MULTI_SOURCE_BATCH) {
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << (row * 7 + row / 120) % 200 << "\tMovie "
+               << row % 120 << "\t" << 1990 + row % 120 % 11 << "\n";
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    // four pairs share each of 70 second actors, enough for a batch of 64
+    // of them, and the pairs of the last few are searched one at a time
+    vector<pair<string, string>> pairs;
+    for (int end = 0; end < 70; end++) {
+        for (int start = 0; start < 4; start++) {
+            string second = "Actor " + to_string(end * 2);
+            pairs.emplace_back("Actor " + to_string((end * 13 + start) % 200),
+                               second);
+            if (start == 3) {
+                pairs.back().first = "Other " + to_string(end % 50);
+            }
+        }
+    }
+    pairs.emplace_back("Actor 3", "Actor 3");
+    pairs.emplace_back("Nobody", "Actor 0");
+
+    // the batch finds the very paths a one way BFS finds for each pair
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        vector<vector<string>> paths = graph->shortestPaths(pairs, false);
+        ASSERT_EQ(paths.size(), pairs.size());
+        for (unsigned int i = 0; i < pairs.size(); i++) {
+            ASSERT_EQ(paths[i], graph->shortestUnweightedPath(
+                                    pairs[i].first, pairs[i].second));
+        }
+    }
+}
+
+TEST(SimpleTest, TEST_PATH_IDS_WRITTEN_LATER) {
+    writeSampleFile();
+    ActorGraph graph;
+    ASSERT_TRUE(graph.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    graph.buildGraph(false);
+
+    // the ids name the same actors and movies the formatted paths do
+    vector<pair<string, string>> pairs = {{"Kevin Bacon", "Tom Holland"},
+                                          {"Kevin Bacon", "Rose Byrne"},
+                                          {"Kevin Bacon", "Nobody"}};
+    for (bool useWeighted : {false, true}) {
+        vector<vector<int>> ids = graph.shortestPathIds(pairs, useWeighted);
+        vector<vector<string>> paths = graph.shortestPaths(pairs, useWeighted);
+        ASSERT_EQ(ids.size(), paths.size());
+        for (unsigned int i = 0; i < ids.size(); i++) {
+            ASSERT_EQ(ids[i].size(), paths[i].size());
+            for (unsigned int j = 0; j < ids[i].size(); j++) {
+                ostringstream written;
+                if (j % 2 == 0) {
+                    graph.writeActorName(written, ids[i][j]);
+                } else {
+                    graph.writeMovie(written, ids[i][j]);
+                }
+                ASSERT_EQ(written.str(), paths[i][j]);
+            }
+        }
+        ASSERT_EQ(ids[0].size(), 7u);
+        ASSERT_TRUE(ids[1].empty());
+        ASSERT_TRUE(ids[2].empty());
+    }
+}
+
+TEST(SimpleTest, TEST_DISTANCE_ONLY) {
+    // two groups of actors with no movie in common, ties in both
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << (row * 7 + row / 120) % 200 << "\tMovie "
+               << row % 120 << "\t" << 1990 + row % 120 % 11 << "\n";
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    vector<pair<string, string>> pairs;
+    for (int pair = 0; pair < 100; pair++) {
+        pairs.emplace_back("Actor " + to_string(pair),
+                           "Actor " + to_string(199 - pair));
+    }
+    pairs.emplace_back("Actor 3", "Other 3");
+    pairs.emplace_back("Actor 3", "Actor 3");
+    pairs.emplace_back("Nobody", "Actor 3");
+
+    // the length of the path each search finds, -1 if it finds none
+    auto length = [](const vector<string>& path, bool useWeighted) {
+        if (path.empty()) {
+            return -1;
+        }
+        int total = 0;
+        for (unsigned int i = 1; i < path.size(); i += 2) {
+            total += useWeighted ? 2020 - stoi(path[i].substr(
+                                              path[i].find("#@") + 2))
+                                 : 1;
+        }
+        return total;
+    };
+
+    // the plain searches, then the landmarks, the hierarchy and the labels
+    // each stop at the length the path they find has
+    for (int speedup = 0; speedup < 4; speedup++) {
+        for (ActorGraph* graph : {&clique, &bipartite}) {
+            if (speedup == 1) {
+                graph->buildLandmarks(3);
+            } else if (speedup == 2 && graph == &bipartite) {
+                graph->buildHierarchy();
+            } else if (speedup == 3) {
+                ASSERT_TRUE(graph->buildDistanceLabels());
+            }
+            for (bool useWeighted : {false, true}) {
+                vector<int> distances =
+                    graph->shortestDistances(pairs, useWeighted);
+                ASSERT_EQ(distances.size(), pairs.size());
+                for (unsigned int i = 0; i + 2 < pairs.size(); i++) {
+                    vector<string> path =
+                        useWeighted ? graph->shortestWeightedPath(
+                                          pairs[i].first, pairs[i].second)
+                                    : graph->shortestUnweightedPath(
+                                          pairs[i].first, pairs[i].second);
+                    ASSERT_EQ(distances[i], length(path, useWeighted));
+                }
+                ASSERT_EQ(distances[pairs.size() - 2], 0);
+                ASSERT_EQ(distances[pairs.size() - 1], -1);
+            }
+            ASSERT_EQ(graph->weightedDistance("Actor 0", "Actor 199"),
+                      graph->shortestDistances({pairs[0]}, true)[0]);
+            ASSERT_EQ(graph->unweightedDistance("Actor 0", "Actor 199"),
+                      graph->shortestDistances({pairs[0]}, false)[0]);
+        }
+    }
+
+    // a search for the path afterwards still lays it out
+    ASSERT_FALSE(clique.shortestWeightedPath("Actor 0", "Actor 199").empty());
+}
+
+TEST(SimpleTest, TEST_SINGLE_SOURCE_DISTANCES) {
+    // enough actors for the levels and buckets to be split among threads
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 30000; row++) {
+        sample << "Actor " << (row * 7 + row / 3000) % 12000 << "\tMovie "
+               << row % 3000 << "\t" << 1950 + row % 3000 % 61 << "\n";
+    }
+    sample << "Loner\tSolo Movie\t2000\n";
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        graph->setNumThreads(4);
+        for (bool useWeighted : {false, true}) {
+            ActorDistances result;
+            ASSERT_TRUE(graph->allDistances("Actor 5", useWeighted, true,
+                                            result));
+            ASSERT_EQ((int)result.distances.size(), graph->getNumActors());
+
+            // the distances match a search for each pair
+            vector<pair<string, string>> pairs;
+            for (int actorId = 0; actorId < graph->getNumActors();
+                 actorId += 97) {
+                pairs.emplace_back("Actor 5", graph->getActorName(actorId));
+            }
+            vector<int> expected = graph->shortestDistances(pairs, useWeighted);
+            for (unsigned int i = 0; i < pairs.size(); i++) {
+                ASSERT_EQ(result.distances[graph->getActorId(pairs[i].second)],
+                          expected[i]);
+            }
+            ASSERT_EQ(result.distances[graph->getActorId("Loner")], -1);
+
+            // each actor is reached through a neighbor one movie nearer
+            for (int actorId = 0; actorId < graph->getNumActors(); actorId++) {
+                int previous = result.previous[actorId];
+                if (result.distances[actorId] <= 0) {
+                    ASSERT_EQ(previous, -1);
+                    continue;
+                }
+                string movie = graph->formatMovie(result.connectors[actorId]);
+                int weight =
+                    useWeighted
+                        ? 2020 - stoi(movie.substr(movie.find("#@") + 2))
+                        : 1;
+                ASSERT_EQ(result.distances[previous] + weight,
+                          result.distances[actorId]);
+            }
+        }
+        ActorDistances result;
+        ASSERT_FALSE(graph->allDistances("Nobody", true, false, result));
+        ASSERT_TRUE(graph->allDistances("Actor 5", true, false, result));
+        ASSERT_TRUE(result.previous.empty());
+    }
+}
+
+TEST(SimpleTest, TEST_BOUNDED_SEARCHES) {
+    // two groups of actors with no movie in common, ties in both
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int row = 0; row < 600; row++) {
+        sample << "Actor " << (row * 7 + row / 120) % 200 << "\tMovie "
+               << row % 120 << "\t" << 1990 + row % 120 % 11 << "\n";
+        sample << "Other " << row * 3 % 50 << "\tOther Movie " << row % 30
+               << "\t2000\n";
+    }
+    sample.close();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    vector<pair<string, string>> pairs;
+    for (int pair = 0; pair < 50; pair++) {
+        pairs.emplace_back("Actor " + to_string(pair),
+                           "Actor " + to_string(199 - pair));
+    }
+    pairs.emplace_back("Actor 3", "Other 3");
+
+    // a path at the limit is found and one just past it isn't, with the
+    // plain searches, then the landmarks, the hierarchy and the labels
+    for (int speedup = 0; speedup < 4; speedup++) {
+        for (ActorGraph* graph : {&clique, &bipartite}) {
+            if (speedup == 1) {
+                graph->buildLandmarks(3);
+            } else if (speedup == 2 && graph == &bipartite) {
+                graph->buildHierarchy();
+            } else if (speedup == 3) {
+                ASSERT_TRUE(graph->buildDistanceLabels());
+            }
+            for (bool useWeighted : {false, true}) {
+                vector<int> distances =
+                    graph->shortestDistances(pairs, useWeighted);
+                for (unsigned int i = 0; i < pairs.size(); i++) {
+                    const string& first = pairs[i].first;
+                    const string& second = pairs[i].second;
+                    int limit = distances[i] == -1 ? 1000 : distances[i];
+                    vector<string> tooShort =
+                        useWeighted
+                            ? graph->shortestWeightedPath(first, second,
+                                                          limit - 1)
+                            : graph->shortestUnweightedPath(first, second,
+                                                            limit - 1);
+                    ASSERT_TRUE(tooShort.empty());
+                    vector<string> path =
+                        useWeighted
+                            ? graph->shortestWeightedPath(first, second, limit)
+                            : graph->shortestUnweightedPath(first, second,
+                                                            limit);
+                    vector<string> unbounded =
+                        useWeighted
+                            ? graph->shortestWeightedPath(first, second)
+                            : graph->shortestUnweightedPath(first, second);
+                    ASSERT_EQ(path.empty(), distances[i] == -1);
+                    ASSERT_EQ(path.size(), unbounded.size());
+                }
+            }
+        }
+    }
+
+    // the neighborhood holds every actor within the bound, nearest first
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        for (bool useWeighted : {false, true}) {
+            int bound = useWeighted ? 40 : 2;
+            ActorDistances all;
+            ASSERT_TRUE(graph->allDistances("Actor 5", useWeighted, false,
+                                            all));
+            vector<NeighborhoodEntry> entries =
+                graph->neighborhood("Actor 5", bound, useWeighted);
+            ASSERT_EQ(entries[0].actorId, graph->getActorId("Actor 5"));
+            ASSERT_EQ(entries[0].previous, -1);
+            int numWithin = 0;
+            for (int distance : all.distances) {
+                numWithin += distance != -1 && distance <= bound;
+            }
+            ASSERT_EQ((int)entries.size(), numWithin);
+            for (unsigned int i = 0; i < entries.size(); i++) {
+                ASSERT_EQ(entries[i].distance,
+                          all.distances[entries[i].actorId]);
+                if (i > 0) {
+                    ASSERT_LE(entries[i - 1].distance, entries[i].distance);
+                    ASSERT_LT(all.distances[entries[i].previous],
+                              entries[i].distance);
+                }
+            }
+        }
+        ASSERT_TRUE(graph->neighborhood("Nobody", 3, false).empty());
+        ASSERT_EQ(graph->neighborhood("Actor 5", 0, false).size(), 1u);
+    }
+}
+
+TEST(SimpleTest, TEST_COMPONENTS) {
+    writeSampleFile();
+    ActorGraph clique;
+    ActorGraph bipartite;
+    ASSERT_TRUE(clique.loadFromFile(SAMPLE_FILE, false));
+    ASSERT_TRUE(bipartite.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    clique.buildGraph(false);
+    bipartite.buildBipartiteGraph();
+
+    for (ActorGraph* graph : {&clique, &bipartite}) {
+        ASSERT_EQ(graph->componentOf("Kevin Bacon"),
+                  graph->componentOf("Tom Holland"));
+        ASSERT_NE(graph->componentOf("Kevin Bacon"),
+                  graph->componentOf("Rose Byrne"));
+        ASSERT_EQ(graph->componentOf("Nobody"), -1);
+        ASSERT_EQ(graph->componentSizes(), vector<int>({4, 1}));
+
+        // a pair in different components has no path or distance
+        ASSERT_TRUE(
+            graph->shortestUnweightedPath("Tom Holland", "Rose Byrne").empty());
+        ASSERT_TRUE(
+            graph->shortestWeightedPath("Rose Byrne", "Kevin Bacon").empty());
+        vector<pair<string, string>> pairs = {{"Tom Holland", "Rose Byrne"},
+                                              {"Tom Holland", "Kevin Bacon"}};
+        vector<vector<string>> paths = graph->shortestPaths(pairs, false);
+        ASSERT_TRUE(paths[0].empty());
+        ASSERT_EQ(paths[1].size(), 7u);
+        ASSERT_EQ(graph->shortestDistances(pairs, true)[0], -1);
+    }
+
+    // the snapshot keeps the components and ingest joins them
+    ASSERT_TRUE(bipartite.saveSnapshot(SNAPSHOT_FILE));
+    ActorGraph mapped;
+    ASSERT_TRUE(mapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    ASSERT_EQ(mapped.componentSizes(), vector<int>({4, 1}));
+
+    // the components are the last section, five ids padded to eight bytes,
+    // so Rose Byrne's id is eight bytes from the end and jumping it ahead is
+    // refused
+    ASSERT_TRUE(bipartite.saveSnapshot(SNAPSHOT_FILE));
+    fstream corrupt(SNAPSHOT_FILE, ios::in | ios::out | ios::binary);
+    corrupt.seekp(-8, ios::end);
+    int skipped = 7;
+    corrupt.write((const char*)&skipped, sizeof(skipped));
+    corrupt.close();
+    ActorGraph broken;
+    ASSERT_FALSE(broken.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    mapped.ingest({{"Rose Byrne", "Split", 2016}});
+    ASSERT_EQ(mapped.componentSizes(), vector<int>({5}));
+    ASSERT_EQ(mapped.shortestUnweightedPath("Tom Holland", "Rose Byrne").size(),
+              7u);
+    mapped.ingest({{"Zendaya", "Dune", 2018}});
+    ASSERT_TRUE(mapped.shortestWeightedPath("Zendaya", "Rose Byrne").empty());
+    ASSERT_EQ(mapped.componentSizes(), vector<int>({5, 1}));
+    ASSERT_TRUE(mapped.saveSnapshot(SNAPSHOT_FILE));
+    ActorGraph remapped;
+    ASSERT_TRUE(remapped.loadSnapshot(SNAPSHOT_FILE));
+    remove(SNAPSHOT_FILE);
+    ASSERT_EQ(remapped.componentSizes(), vector<int>({5, 1}));
+
+    // enough movies to be joined on several threads, three chains of actors
+    ofstream sample(SAMPLE_FILE);
+    sample << "Actor/Actress\tMovie\tYear\n";
+    for (int movie = 0; movie < 12000; movie++) {
+        sample << "Actor " << movie << "\tMovie " << movie << "\t2000\n";
+        if ((movie + 1) % 4000 != 0) {
+            sample << "Actor " << movie + 1 << "\tMovie " << movie
+                   << "\t2000\n";
+        }
+    }
+    sample.close();
+    ActorGraph chains;
+    ASSERT_TRUE(chains.loadFromFile(SAMPLE_FILE, false));
+    remove(SAMPLE_FILE);
+    chains.setNumThreads(4);
+    chains.buildBipartiteGraph();
+    ASSERT_EQ(chains.componentSizes(), vector<int>({4000, 4000, 4000}));
+    ASSERT_EQ(chains.componentOf("Actor 0"), chains.componentOf("Actor 3999"));
+    ASSERT_NE(chains.componentOf("Actor 3999"),
+              chains.componentOf("Actor 4000"));
+    chains.ingest({{"Actor 4000", "Movie 3999", 2000}});
+    ASSERT_EQ(chains.componentSizes(), vector<int>({8000, 4000}));
+    ASSERT_EQ(chains.componentOf("Actor 0"), chains.componentOf("Actor 7999"));
+    ASSERT_EQ(chains.shortestUnweightedPath("Actor 0", "Actor 4001").size(),
+              8003u);
+}